@@ -1,4 +1,5 @@
 #include "plugin.hpp"
+#include "Denormals.hpp"
 
 // Circular buffer for grain delay
 struct GrainBuffer {
@@ -174,6 +175,8 @@ struct AngelGrain : Module {
     }
 
     void process(const ProcessArgs& args) override {
+        DenormalGuard denormalGuard;
+
         float sampleRate = args.sampleRate;
 
         // Get parameters with CV modulation
@@ -204,8 +207,8 @@ struct AngelGrain : Module {
                        inputs[RIGHT_INPUT].getVoltage() / 5.0f : inputL;
 
         // Write input + feedback to buffer
-        float writeL = inputL + feedbackL;
-        float writeR = inputR + feedbackR;
+        float writeL = inputL + feedbackL + ANTI_DENORMAL;
+        float writeR = inputR + feedbackR + ANTI_DENORMAL;
         grainBuffer.write(writeL, writeR);
 
         // Grain scheduling
@@ -1,9 +1,15 @@
 #include "plugin.hpp"
+#include "Oversampler.hpp"
+#include "Denormals.hpp"
+
+using simd::float_4;
 
 // Simple ring buffer for lookahead delay
+// T is float for the full-band path or float_4 for four crossover bands
+template <typename T>
 struct RingBuffer {
     static constexpr int MAX_SIZE = 4096;
-    float buffer[MAX_SIZE] = {};
+    T buffer[MAX_SIZE] = {};
     int writePos = 0;
     int size = 256;
 
@@ -11,26 +17,420 @@ struct RingBuffer {
         size = clamp(newSize, 1, MAX_SIZE - 1);
     }
 
-    void push(float sample) {
+    void push(T sample) {
         buffer[writePos] = sample;
         writePos = (writePos + 1) % size;
     }
 
-    float read(int delay) const {
-        int readPos = (writePos - delay + size * 2) % size;
+    // delay = 0 is the most recently pushed sample
+    T read(int delay) const {
+        int readPos = (writePos - 1 - delay + size * 2) % size;
         return buffer[readPos];
     }
 
     void clear() {
-        std::fill(std::begin(buffer), std::end(buffer), 0.f);
+        std::fill(std::begin(buffer), std::end(buffer), T(0.f));
         writePos = 0;
     }
 };
 
+// Sliding-window maximum over the last `window` pushes, O(1) amortized.
+// A monotonic deque keeps candidate values in decreasing order; anything
+// smaller than a newer value can never be the maximum again and is dropped.
+struct SlidingMax {
+    typedef float T;
+    static constexpr int CAPACITY = 4096;  // Power of two
+    static constexpr uint32_t MASK = CAPACITY - 1;
+
+    float values[CAPACITY] = {};
+    uint32_t stamps[CAPACITY] = {};
+    uint32_t front = 0, back = 0;
+    uint32_t now = 0;
+    uint32_t window = 1;
+
+    void setWindow(int w) {
+        window = clamp(w, 1, CAPACITY);
+        clear();
+    }
+
+    void clear() {
+        front = back = 0;
+    }
+
+    float push(float x) {
+        while (back != front && values[(back - 1) & MASK] <= x) back--;
+        values[back & MASK] = x;
+        stamps[back & MASK] = now;
+        back++;
+        if (now - stamps[front & MASK] >= window) front++;
+        now++;
+        return values[front & MASK];
+    }
+};
+
+// Four-lane sliding-window maximum of non-negative values (van Herk /
+// Gil-Werman). The stream is cut into blocks of `window` samples; the window
+// max is the suffix max of the previous block joined with the running max of
+// the current one. No data-dependent branches, so it vectorizes where the
+// deque cannot, at the cost of one backward pass per block.
+struct SlidingMax4 {
+    typedef float_4 T;
+    static constexpr int CAPACITY = SlidingMax::CAPACITY;
+
+    float_4 block[CAPACITY];
+    float_4 suffix[CAPACITY + 1];
+    float_4 prefix = 0.f;
+    int pos = 0;
+    int window = 1;
+
+    SlidingMax4() {
+        clear();
+    }
+
+    void setWindow(int w) {
+        window = clamp(w, 1, CAPACITY);
+        clear();
+    }
+
+    void clear() {
+        std::fill(std::begin(block), std::end(block), float_4(0.f));
+        std::fill(std::begin(suffix), std::end(suffix), float_4(0.f));
+        prefix = 0.f;
+        pos = 0;
+    }
+
+    float_4 push(float_4 x) {
+        block[pos] = x;
+        prefix = (pos == 0) ? x : simd::fmax(prefix, x);
+        float_4 m = simd::fmax(prefix, suffix[pos + 1]);
+
+        if (++pos >= window) {
+            float_4 s = 0.f;
+            for (int i = window - 1; i >= 0; i--) {
+                s = simd::fmax(s, block[i]);
+                suffix[i] = s;
+            }
+            pos = 0;
+        }
+        return m;
+    }
+};
+
+// Lookahead peak limiter gain computer, one channel per lane of TWindow::T.
+// The required gain is held over the lookahead window (via the sliding peak
+// max) and then averaged over the same span, so the gain ramps down smoothly
+// and reaches its target exactly when the peak leaves the delay line.
+template <typename TWindow>
+struct LookaheadLimiter {
+    typedef typename TWindow::T T;
+    static constexpr int CAPACITY = TWindow::CAPACITY;
+
+    TWindow peakWindow;
+    T history[CAPACITY];
+    T sum = 0.f;
+    int pos = 0;
+    int length = 1;
+    T held = 1.f;
+    float releaseCoeff = 0.001f;
+
+    LookaheadLimiter() {
+        reset();
+    }
+
+    void setLookahead(int samples) {
+        length = clamp(samples, 1, CAPACITY - 1);
+        peakWindow.setWindow(length + 1);
+        reset();
+    }
+
+    void reset() {
+        peakWindow.clear();
+        std::fill(std::begin(history), std::end(history), T(1.f));
+        sum = (float)length;
+        pos = 0;
+        held = 1.f;
+    }
+
+    // peak: |x| of the sample entering the delay line; returns the gain for
+    // the sample leaving it
+    T process(T peak, T threshold) {
+        T windowPeak = peakWindow.push(peak);
+        T target = simd::fmin(threshold / simd::fmax(windowPeak, 1e-9f), 1.f);
+
+        // Attack is instant here (the averaging shapes it); release is smooth
+        held = simd::fmin(target, held + releaseCoeff * (target - held));
+
+        // Moving average over the lookahead span, re-summed once per lap so
+        // rounding errors cannot accumulate
+        sum += held - history[pos];
+        history[pos] = held;
+        if (++pos >= length) {
+            pos = 0;
+            sum = 0.f;
+            for (int i = 0; i < length; i++) sum += history[i];
+        }
+        return sum / (float)length;
+    }
+};
+
+// Biquad over four independent lanes (transposed direct form II)
+struct Biquad4 {
+    float_4 b0 = 1.f, b1 = 0.f, b2 = 0.f, a1 = 0.f, a2 = 0.f;
+    float_4 s1 = 0.f, s2 = 0.f;
+
+    enum Type { PASS, LOWPASS, HIGHPASS, ALLPASS };
+
+    // Butterworth (Q = 1/sqrt2) sections; two in series make a
+    // Linkwitz-Riley 4th-order slope, and the LR4 low + high sum equals the
+    // allpass at the same frequency
+    void setLane(int lane, Type type, float cutoff, float sampleRate) {
+        if (type == PASS) {
+            b0[lane] = 1.f;
+            b1[lane] = b2[lane] = a1[lane] = a2[lane] = 0.f;
+            return;
+        }
+        float w0 = 2.f * M_PI * clamp(cutoff, 10.f, 0.45f * sampleRate) / sampleRate;
+        float cosw0 = std::cos(w0);
+        float alpha = std::sin(w0) / (2.f * M_SQRT1_2);
+        float norm = 1.f / (1.f + alpha);
+
+        a1[lane] = -2.f * cosw0 * norm;
+        a2[lane] = (1.f - alpha) * norm;
+        if (type == LOWPASS) {
+            b0[lane] = b2[lane] = (1.f - cosw0) * 0.5f * norm;
+            b1[lane] = (1.f - cosw0) * norm;
+        } else if (type == HIGHPASS) {
+            b0[lane] = b2[lane] = (1.f + cosw0) * 0.5f * norm;
+            b1[lane] = -(1.f + cosw0) * norm;
+        } else {
+            b0[lane] = a2[lane];
+            b1[lane] = a1[lane];
+            b2[lane] = 1.f;
+        }
+    }
+
+    void reset() {
+        s1 = s2 = 0.f;
+    }
+
+    float_4 process(float_4 x) {
+        float_4 y = b0 * x + s1;
+        s1 = b1 * x - a1 * y + s2 + ANTI_DENORMAL;
+        s2 = b2 * x - a2 * y;
+        return y;
+    }
+};
+
+// Splits one signal into up to four Linkwitz-Riley bands, one per lane.
+// A split at the middle crossover is followed by a split of each half, so
+// every lane runs the same three vector stages. Each half is then allpassed
+// at the other half's crossover, which makes the bands sum back to a flat
+// (allpass) response. Unused lanes stay silent.
+struct Crossover {
+    Biquad4 split[2];
+    Biquad4 band[2];
+    Biquad4 phase;
+    float_4 laneMask = 0.f;
+
+    void setup(int bands, float sampleRate) {
+        typedef Biquad4::Type T;
+        const T P = Biquad4::PASS, L = Biquad4::LOWPASS, H = Biquad4::HIGHPASS, A = Biquad4::ALLPASS;
+        T splitType[4] = {P, P, P, P};
+        T bandType[4] = {P, P, P, P};
+        T phaseType[4] = {P, P, P, P};
+        float splitFreq = 0.f, lowFreq = 0.f, highFreq = 0.f;
+
+        if (bands == 2) {
+            splitFreq = 250.f;
+            splitType[0] = L;
+            splitType[1] = H;
+        } else if (bands == 3) {
+            lowFreq = 200.f;
+            splitFreq = 2500.f;
+            splitType[0] = splitType[1] = L;
+            splitType[2] = H;
+            bandType[0] = L;
+            bandType[1] = H;
+            phaseType[2] = A;
+        } else if (bands == 4) {
+            lowFreq = 120.f;
+            splitFreq = 800.f;
+            highFreq = 4000.f;
+            splitType[0] = splitType[1] = L;
+            splitType[2] = splitType[3] = H;
+            bandType[0] = bandType[2] = L;
+            bandType[1] = bandType[3] = H;
+            phaseType[0] = phaseType[1] = A;
+            phaseType[2] = phaseType[3] = A;
+        }
+
+        for (int i = 0; i < 4; i++) {
+            bool lowHalf = (i < 2);
+            for (int j = 0; j < 2; j++) {
+                split[j].setLane(i, splitType[i], splitFreq, sampleRate);
+                band[j].setLane(i, bandType[i], lowHalf ? lowFreq : highFreq, sampleRate);
+            }
+            // Low half is compensated for the high crossover and vice versa
+            phase.setLane(i, phaseType[i], lowHalf ? highFreq : lowFreq, sampleRate);
+            laneMask[i] = (i < bands) ? 1.f : 0.f;
+        }
+        reset();
+    }
+
+    void reset() {
+        for (int j = 0; j < 2; j++) {
+            split[j].reset();
+            band[j].reset();
+        }
+        phase.reset();
+    }
+
+    float_4 process(float x) {
+        float_4 v = float_4(x) * laneMask;
+        v = split[1].process(split[0].process(v));
+        v = band[1].process(band[0].process(v));
+        return phase.process(v);
+    }
+};
+
+inline float sumLanes(float_4 v) {
+    return v[0] + v[1] + v[2] + v[3];
+}
+
+// Attack/release peak followers, one per lane. Coefficients come from time
+// constants, so the ballistics do not change with the sample rate.
+struct PeakFollower4 {
+    float_4 env = 0.f;
+    float attackCoeff = 1.f;
+    float releaseCoeff = 0.f;
+
+    void setTimes(float attack, float release, float sampleRate) {
+        attackCoeff = 1.f - std::exp(-1.f / (attack * sampleRate));
+        releaseCoeff = 1.f - std::exp(-1.f / (release * sampleRate));
+    }
+
+    void reset() {
+        env = 0.f;
+    }
+
+    float_4 process(float_4 x) {
+        float_4 coeff = simd::ifelse(x > env, float_4(attackCoeff), float_4(releaseCoeff));
+        env += coeff * (x - env);
+        return env;
+    }
+};
+
+// Inter-sample peak detector: 4x polyphase FIR interpolation with the
+// 48-tap filter from ITU-R BS.1770-4 Annex 2. The four phases run as the
+// lanes of one float_4, so the cost is 12 vector multiply-adds per sample.
+struct TruePeakDetector {
+    static constexpr int TAPS = 12;
+    // The reported peak lies between the samples DELAY and DELAY + 1 back
+    static constexpr int DELAY = 5;
+
+    float_4 coeffs[TAPS];
+    float hist[2 * TAPS] = {};
+    int pos = 0;
+
+    TruePeakDetector() {
+        static const float phases[4][TAPS] = {
+            {0.0017089843750f, 0.0109863281250f, -0.0196533203125f, 0.0332031250000f, -0.0594482421875f, 0.1373291015625f,
+             0.9721679687500f, -0.1022949218750f, 0.0476074218750f, -0.0266113281250f, 0.0148925781250f, -0.0083007812500f},
+            {-0.0291748046875f, 0.0292968750000f, -0.0517578125000f, 0.0891113281250f, -0.1665039062500f, 0.4650878906250f,
+             0.7797851562500f, -0.2003173828125f, 0.1015625000000f, -0.0582275390625f, 0.0330810546875f, -0.0189208984375f},
+            {-0.0189208984375f, 0.0330810546875f, -0.0582275390625f, 0.1015625000000f, -0.2003173828125f, 0.7797851562500f,
+             0.4650878906250f, -0.1665039062500f, 0.0891113281250f, -0.0517578125000f, 0.0292968750000f, -0.0291748046875f},
+            {-0.0083007812500f, 0.0148925781250f, -0.0266113281250f, 0.0476074218750f, -0.1022949218750f, 0.9721679687500f,
+             0.1373291015625f, -0.0594482421875f, 0.0332031250000f, -0.0196533203125f, 0.0109863281250f, 0.0017089843750f},
+        };
+        for (int j = 0; j < TAPS; j++) {
+            coeffs[j] = float_4(phases[0][j], phases[1][j], phases[2][j], phases[3][j]);
+        }
+    }
+
+    void reset() {
+        std::fill(std::begin(hist), std::end(hist), 0.f);
+        pos = 0;
+    }
+
+    float process(float x) {
+        pos = (pos == 0) ? TAPS - 1 : pos - 1;
+        hist[pos] = x;
+        hist[pos + TAPS] = x;
+
+        float_4 acc = 0.f;
+        for (int j = 0; j < TAPS; j++) {
+            acc += coeffs[j] * hist[pos + j];
+        }
+        acc = simd::abs(acc);
+        float peak = std::max(std::max(acc[0], acc[1]), std::max(acc[2], acc[3]));
+        // The interpolated points fall inside the interval, so include its ends
+        return std::max(peak, std::max(std::abs(hist[pos + DELAY]), std::abs(hist[pos + DELAY + 1])));
+    }
+};
+
+enum ClipShape {
+    CLIP_HARD,
+    CLIP_CUBIC,
+    CLIP_TANH,
+    CLIP_SINE,
+    CLIP_SHAPES_LEN
+};
+
+// Saturating curves with unity slope at zero that level off at 1, tabulated
+// over u = |x| / threshold in [0, RANGE] and flat beyond
+struct ClipTables {
+    static const int SIZE = 1024;
+    static constexpr float RANGE = 8.f;
+
+    float table[CLIP_SHAPES_LEN][SIZE + 2];
+
+    ClipTables() {
+        for (int i = 0; i <= SIZE + 1; i++) {
+            double u = std::min(i, (int)SIZE) * (double)RANGE / SIZE;
+            table[CLIP_HARD][i] = (float)std::min(u, 1.0);
+            table[CLIP_CUBIC][i] = (float)(u < 1.5 ? u - (4.0 / 27.0) * u * u * u : 1.0);
+            table[CLIP_TANH][i] = (float)std::tanh(u);
+            table[CLIP_SINE][i] = (float)(u < M_PI / 2 ? std::sin(u) : 1.0);
+        }
+    }
+
+    static const ClipTables& get() {
+        static ClipTables tables;
+        return tables;
+    }
+
+    float lookup(int shape, float u) const {
+        float index = std::min(u * (SIZE / RANGE), (float)SIZE);
+        int i = (int)index;
+        float frac = index - i;
+        const float* t = table[shape];
+        return t[i] + frac * (t[i + 1] - t[i]);
+    }
+};
+
+inline float_4 softClip(int shape, float_4 x, float_4 threshold) {
+    if (shape == CLIP_HARD) {
+        return simd::clamp(x, -threshold, threshold);
+    }
+    const ClipTables& tables = ClipTables::get();
+    float_4 u = simd::abs(x) / threshold;
+    float_4 y;
+    for (int i = 0; i < 4; i++) {
+        y[i] = tables.lookup(shape, u[i]);
+    }
+    y *= threshold;
+    return simd::ifelse(x < 0.f, -y, y);
+}
+
 struct AutoClip : Module {
     enum ParamId {
         THRESHOLD_PARAM,
         SOLO_PARAM,
+        BAND1_THRESHOLD_PARAM,
+        BAND2_THRESHOLD_PARAM,
+        BAND3_THRESHOLD_PARAM,
+        BAND4_THRESHOLD_PARAM,
         PARAMS_LEN
     };
     enum InputId {
@@ -49,19 +449,51 @@ struct AutoClip : Module {
         LIGHTS_LEN
     };
 
+    float sampleRate = 44100.f;
+
     // Lookahead delay buffers (5ms at 48kHz ≈ 240 samples)
-    RingBuffer delayL;
-    RingBuffer delayR;
+    RingBuffer<float> delayL;
+    RingBuffer<float> delayR;
     int lookaheadSamples = 240;
 
+    // Multiband mode: 1 = full band, otherwise 2-4 crossover bands that share
+    // the lookahead delay
+    int bands = 1;
+    Crossover crossoverL;
+    Crossover crossoverR;
+    RingBuffer<float_4> bandDelayL;
+    RingBuffer<float_4> bandDelayR;
+    LookaheadLimiter<SlidingMax4> bandLimiter;
+    LookaheadLimiter<SlidingMax4> bandLimiterR;  // Unlinked stereo only
+
     // Gain smoothing
-    float smoothedGain = 1.f;
+    float smoothedGainL = 1.f;
+    float smoothedGainR = 1.f;
     float gainSmoothingCoeff = 0.001f;  // ~50ms at 48kHz
 
-    // Peak detection (per block, approximated with decay)
-    float inputPeak = 0.f;
-    float outputPeak = 0.f;
-    float peakDecay = 0.9999f;
+    // Peak detection on (input L, input R, output L, output R)
+    PeakFollower4 peakFollower;
+
+    // Linked: one gain for both channels, from the louder side.
+    // Unlinked: limiter and makeup gain run per channel.
+    bool stereoLinked = true;
+
+    // Lookahead limiting ahead of the clipper
+    LookaheadLimiter<SlidingMax> limiter;
+    LookaheadLimiter<SlidingMax> limiterR;  // Unlinked stereo only
+    bool limiterEnabled = true;
+
+    // True-peak limiting (full band); delays the audio by DELAY more samples
+    TruePeakDetector truePeakL;
+    TruePeakDetector truePeakR;
+    bool truePeak = false;
+
+    // Clip curve and its oversampling. In full band, lanes 0-1 carry the
+    // signal to clip and lanes 2-3 the dry signal, so solo stays aligned.
+    // In multiband, [0] and [1] carry the bands and [2] the dry pair.
+    int clipShape = CLIP_HARD;
+    int clipOversampling = 1;
+    Oversampler<float_4> clipOversampler[3];
 
     // Clip indicator
     dsp::PulseGenerator clipPulse;
@@ -76,6 +508,12 @@ struct AutoClip : Module {
         // Solo: toggle to hear only what's clipped
         configSwitch(SOLO_PARAM, 0.f, 1.f, 0.f, "Clip Solo", {"Off", "On"});
 
+        // Per-band thresholds relative to the main threshold (multiband mode)
+        const char* bandNames[4] = {"Low", "Low mid", "High mid", "High"};
+        for (int i = 0; i < 4; i++) {
+            configParam(BAND1_THRESHOLD_PARAM + i, -12.f, 12.f, 0.f, string::f("%s band threshold", bandNames[i]), " dB");
+        }
+
         configInput(LEFT_INPUT, "Left audio");
         configInput(RIGHT_INPUT, "Right audio");
         configInput(THRESHOLD_CV_INPUT, "Threshold CV");
@@ -88,18 +526,164 @@ struct AutoClip : Module {
     }
 
     void onSampleRateChange() override {
-        float sampleRate = APP->engine->getSampleRate();
+        setSampleRate(APP->engine->getSampleRate());
+    }
+
+    // Sets every time constant from the rate alone, so the ballistics are the
+    // same at any rate (test/SampleRateTest.cpp checks this without an engine)
+    void setSampleRate(float newSampleRate) {
+        sampleRate = newSampleRate;
         lookaheadSamples = static_cast<int>(0.005f * sampleRate);  // 5ms
-        delayL.setSize(lookaheadSamples + 1);
-        delayR.setSize(lookaheadSamples + 1);
+        delayL.setSize(lookaheadSamples + TruePeakDetector::DELAY + 1);
+        delayR.setSize(lookaheadSamples + TruePeakDetector::DELAY + 1);
         delayL.clear();
         delayR.clear();
+        truePeakL.reset();
+        truePeakR.reset();
 
         // Gain smoothing: ~50ms time constant
         gainSmoothingCoeff = 1.f - std::exp(-1.f / (0.05f * sampleRate));
+
+        // Limiter looks ahead over the whole delay; ~100ms release
+        float limiterRelease = 1.f - std::exp(-1.f / (0.1f * sampleRate));
+        limiter.setLookahead(lookaheadSamples);
+        limiterR.setLookahead(lookaheadSamples);
+        bandLimiter.setLookahead(lookaheadSamples);
+        bandLimiterR.setLookahead(lookaheadSamples);
+        limiter.releaseCoeff = limiterRelease;
+        limiterR.releaseCoeff = limiterRelease;
+        bandLimiter.releaseCoeff = limiterRelease;
+        bandLimiterR.releaseCoeff = limiterRelease;
+
+        // Makeup gain peak followers: 1ms attack, 200ms release
+        peakFollower.setTimes(0.001f, 0.2f, sampleRate);
+        peakFollower.reset();
+
+        setupBands();
+    }
+
+    void setClipOversampling(int factor) {
+        clipOversampling = clamp(factor, 1, 4);
+        for (int i = 0; i < 3; i++) {
+            clipOversampler[i].setFactor(clipOversampling);
+        }
+    }
+
+    void setBands(int count) {
+        bands = clamp(count, 1, 4);
+        setupBands();
+    }
+
+    void setupBands() {
+        crossoverL.setup(bands, sampleRate);
+        crossoverR.setup(bands, sampleRate);
+        bandDelayL.setSize(lookaheadSamples + 1);
+        bandDelayR.setSize(lookaheadSamples + 1);
+        bandDelayL.clear();
+        bandDelayR.clear();
+        bandLimiter.reset();
+        bandLimiterR.reset();
+    }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = json_object();
+        json_object_set_new(rootJ, "limiter", json_boolean(limiterEnabled));
+        json_object_set_new(rootJ, "bands", json_integer(bands));
+        json_object_set_new(rootJ, "truePeak", json_boolean(truePeak));
+        json_object_set_new(rootJ, "stereoLinked", json_boolean(stereoLinked));
+        json_object_set_new(rootJ, "clipShape", json_integer(clipShape));
+        json_object_set_new(rootJ, "clipOversampling", json_integer(clipOversampling));
+        return rootJ;
+    }
+
+    void dataFromJson(json_t* rootJ) override {
+        json_t* limiterJ = json_object_get(rootJ, "limiter");
+        if (limiterJ) limiterEnabled = json_boolean_value(limiterJ);
+
+        json_t* bandsJ = json_object_get(rootJ, "bands");
+        if (bandsJ) setBands(json_integer_value(bandsJ));
+
+        json_t* truePeakJ = json_object_get(rootJ, "truePeak");
+        if (truePeakJ) truePeak = json_boolean_value(truePeakJ);
+
+        json_t* stereoLinkedJ = json_object_get(rootJ, "stereoLinked");
+        if (stereoLinkedJ) stereoLinked = json_boolean_value(stereoLinkedJ);
+
+        json_t* clipShapeJ = json_object_get(rootJ, "clipShape");
+        if (clipShapeJ) clipShape = clamp((int)json_integer_value(clipShapeJ), 0, CLIP_SHAPES_LEN - 1);
+
+        json_t* clipOversamplingJ = json_object_get(rootJ, "clipOversampling");
+        if (clipOversamplingJ) setClipOversampling(json_integer_value(clipOversamplingJ));
+    }
+
+    // Shape the lanes selected by clipMask at the oversampled rate; the other
+    // lanes only pass through the filters
+    float_4 clipOversampled(Oversampler<float_4>& os, float_4 x, float_4 threshold, float_4 clipMask) {
+        float_4 buf[Oversampler<float_4>::MAX_FACTOR];
+        os.upsample(x, buf);
+        for (int i = 0; i < os.factor; i++) {
+            buf[i] = simd::ifelse(clipMask, softClip(clipShape, buf[i], threshold), buf[i]);
+        }
+        return os.downsample(buf);
+    }
+
+    // Crossover, delay, limit and clip each band in its own lane, then sum.
+    // Returns true if any band went over its threshold.
+    bool processBands(float inputL, float inputR, float clipThreshold,
+                      float& delayedL, float& delayedR, float& clippedL, float& clippedR) {
+        float_4 bandL = crossoverL.process(inputL);
+        float_4 bandR = crossoverR.process(inputR);
+        bandDelayL.push(bandL);
+        bandDelayR.push(bandR);
+        float_4 delayedBandL = bandDelayL.read(lookaheadSamples);
+        float_4 delayedBandR = bandDelayR.read(lookaheadSamples);
+
+        // dB offsets to linear: 10^(dB / 20)
+        float_4 trims(params[BAND1_THRESHOLD_PARAM].getValue(), params[BAND2_THRESHOLD_PARAM].getValue(),
+                      params[BAND3_THRESHOLD_PARAM].getValue(), params[BAND4_THRESHOLD_PARAM].getValue());
+        float_4 thresholds = clipThreshold * simd::exp(trims * (float)(M_LN10 / 20.0));
+
+        float_4 limitedL = delayedBandL;
+        float_4 limitedR = delayedBandR;
+        if (limiterEnabled) {
+            if (stereoLinked) {
+                float_4 gains = bandLimiter.process(simd::fmax(simd::abs(bandL), simd::abs(bandR)), thresholds);
+                limitedL *= gains;
+                limitedR *= gains;
+            } else {
+                limitedL *= bandLimiter.process(simd::abs(bandL), thresholds);
+                limitedR *= bandLimiterR.process(simd::abs(bandR), thresholds);
+            }
+        }
+
+        delayedL = sumLanes(delayedBandL);
+        delayedR = sumLanes(delayedBandR);
+        if (clipOversampling > 1) {
+            float_4 all = float_4::mask();
+            clippedL = sumLanes(clipOversampled(clipOversampler[0], limitedL, thresholds, all));
+            clippedR = sumLanes(clipOversampled(clipOversampler[1], limitedR, thresholds, all));
+            float_4 dry = clipOversampled(clipOversampler[2], float_4(delayedL, delayedR, 0.f, 0.f), 1.f, 0.f);
+            delayedL = dry[0];
+            delayedR = dry[1];
+        } else {
+            clippedL = sumLanes(softClip(clipShape, limitedL, thresholds));
+            clippedR = sumLanes(softClip(clipShape, limitedR, thresholds));
+        }
+
+        float_4 over = (simd::abs(delayedBandL) > thresholds) | (simd::abs(delayedBandR) > thresholds);
+        return simd::movemask(over) != 0;
+    }
+
+    static float makeupGain(float inputPeak, float outputPeak) {
+        if (outputPeak > 0.001f && inputPeak > 0.001f) {
+            return inputPeak / outputPeak;
+        }
+        return 1.f;
     }
 
     void process(const ProcessArgs& args) override {
+        DenormalGuard denormalGuard;
+
         // Read threshold parameter with CV
         float thresholdPercent = params[THRESHOLD_PARAM].getValue();
         if (inputs[THRESHOLD_CV_INPUT].isConnected()) {
@@ -119,52 +703,76 @@ struct AutoClip : Module {
         float inputR = inputs[RIGHT_INPUT].isConnected() ?
                        inputs[RIGHT_INPUT].getVoltage() / 5.f : inputL;
 
-        // Original signal not needed since we use delayed version
-
-        // Push to lookahead buffers
-        delayL.push(inputL);
-        delayR.push(inputR);
-
-        // Read delayed samples
-        float delayedL = delayL.read(lookaheadSamples);
-        float delayedR = delayR.read(lookaheadSamples);
-
-        // Track input peaks (with decay)
-        inputPeak = std::max(inputPeak * peakDecay, std::max(std::abs(delayedL), std::abs(delayedR)));
-
-        // Apply hard clipping
-        float clippedL = clamp(delayedL, -clipThreshold, clipThreshold);
-        float clippedR = clamp(delayedR, -clipThreshold, clipThreshold);
+        float delayedL, delayedR;
+        float clippedL, clippedR;
+        if (bands > 1) {
+            isClipping = processBands(inputL, inputR, clipThreshold, delayedL, delayedR, clippedL, clippedR);
+        } else {
+            // Push to lookahead buffers
+            delayL.push(inputL);
+            delayR.push(inputR);
+
+            // Read delayed samples
+            int delay = lookaheadSamples + (truePeak ? TruePeakDetector::DELAY : 0);
+            delayedL = delayL.read(delay);
+            delayedR = delayR.read(delay);
+            isClipping = (std::abs(delayedL) > clipThreshold || std::abs(delayedR) > clipThreshold);
+
+            // Lookahead limiting, so the clipper only catches what is left
+            float limitedL = delayedL;
+            float limitedR = delayedR;
+            if (limiterEnabled) {
+                float peakL = truePeak ? truePeakL.process(inputL) : std::abs(inputL);
+                float peakR = truePeak ? truePeakR.process(inputR) : std::abs(inputR);
+                if (stereoLinked) {
+                    float limiterGain = limiter.process(std::max(peakL, peakR), clipThreshold);
+                    limitedL *= limiterGain;
+                    limitedR *= limiterGain;
+                } else {
+                    limitedL *= limiter.process(peakL, clipThreshold);
+                    limitedR *= limiterR.process(peakR, clipThreshold);
+                }
+            }
+
+            // Apply clipping
+            float_4 v(limitedL, limitedR, delayedL, delayedR);
+            if (clipOversampling > 1) {
+                v = clipOversampled(clipOversampler[0], v, clipThreshold, float_4(1.f, 1.f, 0.f, 0.f) > 0.f);
+                delayedL = v[2];
+                delayedR = v[3];
+            } else {
+                v = softClip(clipShape, v, clipThreshold);
+            }
+            clippedL = v[0];
+            clippedR = v[1];
+        }
 
-        // Track output peaks
-        outputPeak = std::max(outputPeak * peakDecay, std::max(std::abs(clippedL), std::abs(clippedR)));
+        // Track input and output peaks
+        float_4 peaks = peakFollower.process(simd::abs(float_4(delayedL, delayedR, clippedL, clippedR)));
+        float inputPeakL = peaks[0], inputPeakR = peaks[1];
+        float outputPeakL = peaks[2], outputPeakR = peaks[3];
+        if (stereoLinked) {
+            inputPeakL = inputPeakR = std::max(inputPeakL, inputPeakR);
+            outputPeakL = outputPeakR = std::max(outputPeakL, outputPeakR);
+        }
 
         // Detect if clipping occurred
-        isClipping = (std::abs(delayedL) > clipThreshold || std::abs(delayedR) > clipThreshold);
         if (isClipping) {
             clipPulse.trigger(0.05f);
         }
 
-        // Calculate target gain for compensation
-        float targetGain = 1.f;
-        if (outputPeak > 0.001f && inputPeak > 0.001f) {
-            targetGain = inputPeak / outputPeak;
-        }
-
-        // Smooth the gain
-        smoothedGain += gainSmoothingCoeff * (targetGain - smoothedGain);
+        // Calculate target gain for compensation, then smooth it
+        smoothedGainL += gainSmoothingCoeff * (makeupGain(inputPeakL, outputPeakL) - smoothedGainL);
+        smoothedGainR += gainSmoothingCoeff * (makeupGain(inputPeakR, outputPeakR) - smoothedGainR);
 
         // Apply gain compensation
-        float outputL = clippedL * smoothedGain;
-        float outputR = clippedR * smoothedGain;
+        float outputL = clippedL * smoothedGainL;
+        float outputR = clippedR * smoothedGainR;
 
         // Clip solo: output difference signal
         if (soloClipped) {
-            // Use undelayed original for proper alignment
-            float delayedOrigL = delayL.read(lookaheadSamples);
-            float delayedOrigR = delayR.read(lookaheadSamples);
-            outputL = delayedOrigL - clippedL * smoothedGain;
-            outputR = delayedOrigR - clippedR * smoothedGain;
+            outputL = delayedL - outputL;
+            outputR = delayedR - outputR;
         }
 
         // Output (scale back to ±5V)
@@ -193,8 +801,13 @@ struct AutoClipWidget : ModuleWidget {
         // Solo switch
         addParam(createParamCentered<CKSS>(mm2px(Vec(15.24, 65)), module, AutoClip::SOLO_PARAM));
 
+        // Per-band thresholds
+        for (int i = 0; i < 4; i++) {
+            addParam(createParamCentered<Trimpot>(mm2px(Vec(5.5 + 6.5 * i, 77.5)), module, AutoClip::BAND1_THRESHOLD_PARAM + i));
+        }
+
         // Clip light
-        addChild(createLightCentered<LargeLight<RedLight>>(mm2px(Vec(15.24, 80)), module, AutoClip::CLIP_LIGHT));
+        addChild(createLightCentered<LargeLight<RedLight>>(mm2px(Vec(15.24, 88)), module, AutoClip::CLIP_LIGHT));
 
         // CV input
         addInput(createInputCentered<PJ301MPort>(mm2px(Vec(15.24, 95)), module, AutoClip::THRESHOLD_CV_INPUT));
@@ -205,6 +818,39 @@ struct AutoClipWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(8, 120)), module, AutoClip::LEFT_OUTPUT));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(22.48, 120)), module, AutoClip::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        AutoClip* module = getModule<AutoClip>();
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createBoolMenuItem("Lookahead limiter", "",
+            [=]() { return module->limiterEnabled; },
+            [=](bool enabled) { module->limiterEnabled = enabled; }
+        ));
+        menu->addChild(createIndexSubmenuItem("Bands",
+            {"1 (full band)", "2", "3", "4"},
+            [=]() { return module->bands - 1; },
+            [=](int index) { module->setBands(index + 1); }
+        ));
+        menu->addChild(createBoolMenuItem("Stereo link", "",
+            [=]() { return module->stereoLinked; },
+            [=](bool linked) { module->stereoLinked = linked; }
+        ));
+        menu->addChild(createBoolMenuItem("True-peak limiting", "",
+            [=]() { return module->truePeak; },
+            [=](bool enabled) { module->truePeak = enabled; }
+        ));
+        menu->addChild(createIndexSubmenuItem("Clip shape",
+            {"Hard", "Cubic", "Tanh", "Sine"},
+            [=]() { return module->clipShape; },
+            [=](int index) { module->clipShape = index; }
+        ));
+        menu->addChild(createIndexSubmenuItem("Clip oversampling",
+            {"Off", "2x", "4x"},
+            [=]() { return module->clipOversampling == 4 ? 2 : module->clipOversampling - 1; },
+            [=](int index) { module->setClipOversampling(1 << index); }
+        ));
+    }
 };
 
 Model* modelAutoClip = createModel<AutoClip, AutoClipWidget>("AutoClip");
@@ -0,0 +1,67 @@
+// CPU cost of AutoClip's multiband mode against full band.
+// Runs the whole process() on stereo noise at 48 kHz with the limiter on
+// and the threshold at 50%, for 1 to 4 bands, linked and unlinked, and
+// reports ns per frame and the ratio to full band.
+#include "../src/AutoClip.cpp"
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+Plugin* pluginInstance;
+
+// Best of five runs, to keep scheduler noise out of the figure
+static double nanosecondsPerFrame(int bands, bool linked) {
+    const int FRAMES = 1 << 16;
+    std::vector<float> noiseL(FRAMES), noiseR(FRAMES);
+    uint32_t state = 1;
+    for (int n = 0; n < FRAMES; n++) {
+        // Xorshift32, so every run sees the same input
+        state ^= state << 13;
+        state ^= state >> 17;
+        state ^= state << 5;
+        noiseL[n] = 10.f * (state >> 8) / (1 << 24) - 5.f;
+        noiseR[FRAMES - 1 - n] = noiseL[n];
+    }
+
+    AutoClip clip;
+    clip.setSampleRate(48000.f);
+    clip.setBands(bands);
+    clip.stereoLinked = linked;
+    clip.params[AutoClip::THRESHOLD_PARAM].setValue(50.f);
+    clip.inputs[AutoClip::LEFT_INPUT].setChannels(1);
+    clip.inputs[AutoClip::RIGHT_INPUT].setChannels(1);
+
+    Module::ProcessArgs args;
+    args.sampleRate = 48000.f;
+    args.sampleTime = 1.f / 48000.f;
+    args.frame = 0;
+
+    float sink = 0.f;
+    double best = 1e30;
+    for (int run = 0; run < 5; run++) {
+        auto start = std::chrono::steady_clock::now();
+        for (int n = 0; n < FRAMES; n++) {
+            clip.inputs[AutoClip::LEFT_INPUT].setVoltage(noiseL[n]);
+            clip.inputs[AutoClip::RIGHT_INPUT].setVoltage(noiseR[n]);
+            clip.process(args);
+            sink += clip.outputs[AutoClip::LEFT_OUTPUT].getVoltage();
+        }
+        auto end = std::chrono::steady_clock::now();
+        best = std::min(best, std::chrono::duration<double, std::nano>(end - start).count() / FRAMES);
+    }
+    volatile float keep = sink;
+    (void)keep;
+    return best;
+}
+
+int main() {
+    printf("%-6s %12s %8s %12s %8s\n", "bands", "linked ns", "ratio", "unlinked ns", "ratio");
+    double fullLinked = nanosecondsPerFrame(1, true);
+    double fullUnlinked = nanosecondsPerFrame(1, false);
+    for (int bands = 1; bands <= 4; bands++) {
+        double linked = (bands == 1) ? fullLinked : nanosecondsPerFrame(bands, true);
+        double unlinked = (bands == 1) ? fullUnlinked : nanosecondsPerFrame(bands, false);
+        printf("%-6d %12.1f %7.2fx %12.1f %7.2fx\n", bands, linked, linked / fullLinked, unlinked, unlinked / fullUnlinked);
+    }
+    return 0;
+}
@@ -0,0 +1,133 @@
+// Sample rate regression test for AutoClip's ballistics.
+// Configures the module at 44.1, 48 and 96 kHz, measures the peak follower,
+// makeup gain smoothing and lookahead limiter time constants in seconds, and
+// fails if any of them drifts from its nominal value or between rates.
+#include "../src/AutoClip.cpp"
+#include <cstdio>
+
+Plugin* pluginInstance;
+
+static const float E_FALL = std::exp(-1.f);
+static const float E_RISE = 1.f - E_FALL;
+
+static float lane0(float x) {
+    return x;
+}
+
+static float lane0(float_4 x) {
+    return x[0];
+}
+
+// Time for the attack to cover 1 - 1/e of a step
+static double followerAttack(AutoClip& m) {
+    PeakFollower4 f = m.peakFollower;
+    f.reset();
+    int n = 1;
+    while (f.process(1.f)[0] < E_RISE) n++;
+    return n / m.sampleRate;
+}
+
+// Time for the release to fall to 1/e
+static double followerRelease(AutoClip& m) {
+    PeakFollower4 f = m.peakFollower;
+    f.env = 1.f;
+    int n = 1;
+    while (f.process(0.f)[0] > E_FALL) n++;
+    return n / m.sampleRate;
+}
+
+// Same update as AutoClip::process() applies to the makeup gain
+static double gainSmoothing(AutoClip& m) {
+    float gain = 0.f;
+    int n = 0;
+    while (gain < E_RISE) {
+        gain += m.gainSmoothingCoeff * (1.f - gain);
+        n++;
+    }
+    return n / m.sampleRate;
+}
+
+// Time from a peak entering the lookahead to the gain reaching its target
+template <typename TLimiter>
+static double limiterLookahead(TLimiter& limiter, float sampleRate) {
+    limiter.reset();
+    int n = 1;
+    while (lane0(limiter.process(1.f, 0.5f)) > 0.5f + 1e-6f) n++;
+    return n / sampleRate;
+}
+
+// Time from the last peak for the gain to recover 1 - 1/e of the way back
+template <typename TLimiter>
+static double limiterRelease(TLimiter& limiter, float sampleRate) {
+    limiter.reset();
+    for (int i = 0; i < (int)sampleRate; i++) limiter.process(1.f, 0.5f);
+    int n = 1;
+    while (lane0(limiter.process(0.f, 0.5f)) < 1.f - 0.5f * E_FALL) n++;
+    return n / sampleRate;
+}
+
+struct Measure {
+    const char* name;
+    double (*run)(AutoClip&);
+    // Accepted range of the 44.1 kHz value
+    double low, high;
+};
+
+static double fullLookahead(AutoClip& m) {
+    return limiterLookahead(m.limiter, m.sampleRate);
+}
+
+static double fullRelease(AutoClip& m) {
+    return limiterRelease(m.limiter, m.sampleRate);
+}
+
+static double bandLookahead(AutoClip& m) {
+    return limiterLookahead(m.bandLimiter, m.sampleRate);
+}
+
+static double bandRelease(AutoClip& m) {
+    return limiterRelease(m.bandLimiter, m.sampleRate);
+}
+
+int main() {
+    const float rates[] = {44100.f, 48000.f, 96000.f};
+    const int RATES = 3;
+    // The limiter release adds the averaging window to the 100 ms smoothing
+    const Measure measures[] = {
+        {"follower attack", followerAttack, 0.00095, 0.00105},
+        {"follower release", followerRelease, 0.199, 0.201},
+        {"gain smoothing", gainSmoothing, 0.0495, 0.0505},
+        {"limiter lookahead", fullLookahead, 0.0049, 0.0051},
+        {"limiter release", fullRelease, 0.1, 0.11},
+        {"band lookahead", bandLookahead, 0.0049, 0.0051},
+        {"band release", bandRelease, 0.1, 0.11},
+    };
+
+    AutoClip* module = new AutoClip;
+    int failures = 0;
+    printf("%-20s %10s %10s %10s\n", "", "44.1 kHz", "48 kHz", "96 kHz");
+    for (const Measure& measure : measures) {
+        double t[RATES];
+        for (int r = 0; r < RATES; r++) {
+            module->setSampleRate(rates[r]);
+            t[r] = measure.run(*module);
+        }
+        printf("%-20s %8.3f ms %7.3f ms %7.3f ms", measure.name, t[0] * 1e3, t[1] * 1e3, t[2] * 1e3);
+
+        // Within two samples at the lowest rate, or 0.5% for long constants
+        double tolerance = std::max(2.0 / rates[0], 0.005 * t[0]);
+        bool ok = t[0] >= measure.low && t[0] <= measure.high;
+        for (int r = 1; r < RATES; r++) {
+            ok &= std::abs(t[r] - t[0]) <= tolerance;
+        }
+        printf("  %s\n", ok ? "ok" : "FAIL");
+        if (!ok) failures++;
+    }
+    delete module;
+
+    if (failures) {
+        printf("%d time constant(s) depend on the sample rate\n", failures);
+        return 1;
+    }
+    return 0;
+}
@@ -1,4 +1,8 @@
 #include "plugin.hpp"
+#include "Oversampler.hpp"
+#include "Denormals.hpp"
+#include "DelayResample.hpp"
+#include "ModulatedFDN.hpp"
 
 // Simple comb filter for reverb
 struct CombFilter {
@@ -14,12 +18,23 @@ struct CombFilter {
         size = clamp(newSize, 1, MAX_SIZE - 1);
     }
 
+    // Changes the length keeping the stored tail, stretched to fit
+    void resize(int newSize) {
+        newSize = clamp(newSize, 1, MAX_SIZE - 1);
+        // The line wraps at size, so bring the oldest sample to the front
+        std::rotate(buffer, buffer + writePos, buffer + size);
+        resampleHistory(buffer, MAX_SIZE - 1, 0, size, newSize, (float)newSize / size);
+        size = newSize;
+        writePos = 0;
+    }
+
     float process(float input) {
-        int readPos = (writePos - size + MAX_SIZE) % size;
+        // The oldest sample in the ring, written exactly size samples ago
+        int readPos = writePos;
         float output = buffer[readPos];
 
         // One-pole lowpass filter in feedback loop
-        filterStore = (output * (1.f - damp)) + (filterStore * damp);
+        filterStore = (output * (1.f - damp)) + (filterStore * damp) + ANTI_DENORMAL;
 
         buffer[writePos] = input + (filterStore * feedback);
         writePos = (writePos + 1) % size;
@@ -45,11 +60,22 @@ struct AllpassFilter {
         size = clamp(newSize, 1, MAX_SIZE - 1);
     }
 
+    // Changes the length keeping the stored tail, stretched to fit
+    void resize(int newSize) {
+        newSize = clamp(newSize, 1, MAX_SIZE - 1);
+        // The line wraps at size, so bring the oldest sample to the front
+        std::rotate(buffer, buffer + writePos, buffer + size);
+        resampleHistory(buffer, MAX_SIZE - 1, 0, size, newSize, (float)newSize / size);
+        size = newSize;
+        writePos = 0;
+    }
+
     float process(float input) {
-        int readPos = (writePos - size + MAX_SIZE) % size;
+        // The oldest sample in the ring, written exactly size samples ago
+        int readPos = writePos;
         float bufOut = buffer[readPos];
         float output = -input + bufOut;
-        buffer[writePos] = input + (bufOut * feedback);
+        buffer[writePos] = input + (bufOut * feedback) + ANTI_DENORMAL;
         writePos = (writePos + 1) % size;
         return output;
     }
@@ -105,7 +131,7 @@ struct BiquadFilter {
 
     float process(float input) {
         float output = a0 * input + a1 * z1 + a2 * z2 - b1 * z1 - b2 * z2;
-        float temp = input - b1 * z1 - b2 * z2;
+        float temp = input - b1 * z1 - b2 * z2 + ANTI_DENORMAL;
         output = a0 * temp + a1 * z1 + a2 * z2;
         z2 = z1;
         z1 = temp;
@@ -149,11 +175,33 @@ struct DriveVerb : Module {
     const int allpassTunings[4] = {556, 441, 341, 225};
     const int stereoSpread = 23;
 
+    // Alternative core: modulated 8-line FDN, selected from the context menu
+    enum ReverbCore {
+        FREEVERB_CORE,
+        FDN_CORE
+    };
+    int reverbCore = FREEVERB_CORE;
+    int activeCore = FREEVERB_CORE;
+    ModulatedFDN fdn;
+
     // DJ-style filter
     BiquadFilter filterL;
     BiquadFilter filterR;
     bool previousWasLowPass = false;
 
+    // Drive stage oversampling, left and right in lanes 0 and 1
+    Oversampler<simd::float_4> oversampler;
+    int requestedOversampling = 1;  // Set from the menu, applied at the top of process()
+
+    // Idling: at mix 0 the reverb input is muted. Once the reverb output has
+    // stayed below SILENCE with nothing feeding it for longer than the delay
+    // network can hold a sample, the reverb stops processing and the module
+    // passes the dry signal through until mix is up and input arrives again.
+    static constexpr float SILENCE = 1e-6f;  // -120 dB
+    int quietSamples = 0;
+    int idleAfter = 4096;
+    bool reverbIdle = false;
+
     DriveVerb() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -187,23 +235,56 @@ struct DriveVerb : Module {
         }
     }
 
+    // The engine changes rate between blocks. Rather than clearing the
+    // delay lines (and cutting off a ringing tail), their contents are
+    // re-timed in place to the new rate. All buffers are fixed-size members,
+    // so nothing is allocated. The FDN is only re-timed while in use, since
+    // a core is cleared when switched in.
     void onSampleRateChange() override {
-        float ratio = APP->engine->getSampleRate() / 44100.f;
+        float sampleRate = APP->engine->getSampleRate();
+        float ratio = sampleRate / 44100.f;
         for (int i = 0; i < 8; i++) {
-            combL[i].setSize(static_cast<int>(combTunings[i] * ratio));
-            combR[i].setSize(static_cast<int>((combTunings[i] + stereoSpread) * ratio));
-            combL[i].clear();
-            combR[i].clear();
+            combL[i].resize(static_cast<int>(combTunings[i] * ratio));
+            combR[i].resize(static_cast<int>((combTunings[i] + stereoSpread) * ratio));
         }
         for (int i = 0; i < 4; i++) {
-            allpassL[i].setSize(static_cast<int>(allpassTunings[i] * ratio));
-            allpassR[i].setSize(static_cast<int>((allpassTunings[i] + stereoSpread) * ratio));
-            allpassL[i].clear();
-            allpassR[i].clear();
+            allpassL[i].resize(static_cast<int>(allpassTunings[i] * ratio));
+            allpassR[i].resize(static_cast<int>((allpassTunings[i] + stereoSpread) * ratio));
+        }
+        if (activeCore == FDN_CORE) {
+            fdn.resample(sampleRate);
         }
+
+        // Longer than the longest comb or FDN line plus the allpass chain
+        idleAfter = static_cast<int>(4096 * ratio);
+        quietSamples = 0;
+    }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = json_object();
+        json_object_set_new(rootJ, "oversampling", json_integer(requestedOversampling));
+        json_object_set_new(rootJ, "reverbCore", json_integer(reverbCore));
+        return rootJ;
+    }
+
+    void dataFromJson(json_t* rootJ) override {
+        json_t* oversamplingJ = json_object_get(rootJ, "oversampling");
+        if (oversamplingJ) setOversampling(json_integer_value(oversamplingJ));
+        json_t* reverbCoreJ = json_object_get(rootJ, "reverbCore");
+        if (reverbCoreJ) reverbCore = clamp((int)json_integer_value(reverbCoreJ), 0, 1);
+    }
+
+    // Only records the factor: the UI thread must not touch the oversampler
+    // while process() is running it
+    void setOversampling(int factor) {
+        requestedOversampling = (factor >= 8) ? 8 : (factor >= 4) ? 4 : (factor >= 2) ? 2 : 1;
     }
 
     void process(const ProcessArgs& args) override {
+        DenormalGuard denormalGuard;
+
+        if (requestedOversampling != oversampler.factor) oversampler.setFactor(requestedOversampling);
+
         // Read parameters
         float size = params[SIZE_PARAM].getValue() / 100.f;
         float decay = params[DECAY_PARAM].getValue();
@@ -225,14 +306,6 @@ struct DriveVerb : Module {
         float damp = 0.5f - (size * 0.3f);  // More size = less damping
         damp = clamp(damp, 0.1f, 0.7f);
 
-        // Update comb filters
-        for (int i = 0; i < 8; i++) {
-            combL[i].feedback = feedback;
-            combR[i].feedback = feedback;
-            combL[i].damp = damp;
-            combR[i].damp = damp;
-        }
-
         // Get inputs (normalize to ±1 for processing)
         float inputL = inputs[LEFT_INPUT].getVoltage() / 5.f;
         float inputR = inputs[RIGHT_INPUT].isConnected() ?
@@ -242,26 +315,91 @@ struct DriveVerb : Module {
         float dryL = inputL;
         float dryR = inputR;
 
-        // Process reverb (8 parallel comb filters)
+        // The wet signal is inaudible at mix 0, so let the tail run out
+        bool reverbFed = mix > 0.f;
+        if (!reverbFed) {
+            inputL = inputR = 0.f;
+        }
+        bool silentInput = std::abs(inputL) < SILENCE && std::abs(inputR) < SILENCE;
+
+        if (reverbIdle) {
+            if (silentInput) {
+                // Pass-through: the wet path is silent
+                outputs[LEFT_OUTPUT].setVoltage(dryL * (1.f - mix) * 5.f);
+                outputs[RIGHT_OUTPUT].setVoltage(dryR * (1.f - mix) * 5.f);
+                return;
+            }
+            reverbIdle = false;
+            quietSamples = 0;
+        }
+
+        // The core being switched in starts from silence, not from the
+        // tail it held when it was last used
+        if (reverbCore != activeCore) {
+            activeCore = reverbCore;
+            if (activeCore == FDN_CORE) {
+                fdn.clear();
+            } else {
+                for (int i = 0; i < 8; i++) {
+                    combL[i].clear();
+                    combR[i].clear();
+                }
+                for (int i = 0; i < 4; i++) {
+                    allpassL[i].clear();
+                    allpassR[i].clear();
+                }
+            }
+        }
+
         float wetL = 0.f;
         float wetR = 0.f;
-        for (int i = 0; i < 8; i++) {
-            wetL += combL[i].process(inputL);
-            wetR += combR[i].process(inputR);
+        if (activeCore == FDN_CORE) {
+            // Decay is the RT60 here rather than a comb feedback amount
+            fdn.setParams(size, decay, damp, args.sampleRate);
+            fdn.process(inputL, inputR, wetL, wetR);
+        } else {
+            // Process reverb (8 parallel comb filters)
+            for (int i = 0; i < 8; i++) {
+                combL[i].feedback = feedback;
+                combR[i].feedback = feedback;
+                combL[i].damp = damp;
+                combR[i].damp = damp;
+                wetL += combL[i].process(inputL);
+                wetR += combR[i].process(inputR);
+            }
+            wetL /= 8.f;
+            wetR /= 8.f;
+
+            // Process through 4 series allpass filters
+            for (int i = 0; i < 4; i++) {
+                wetL = allpassL[i].process(wetL);
+                wetR = allpassR[i].process(wetR);
+            }
         }
-        wetL /= 8.f;
-        wetR /= 8.f;
 
-        // Process through 4 series allpass filters
-        for (int i = 0; i < 4; i++) {
-            wetL = allpassL[i].process(wetL);
-            wetR = allpassR[i].process(wetR);
+        // Go idle once the tail has died away
+        if (silentInput && std::abs(wetL) < SILENCE && std::abs(wetR) < SILENCE) {
+            if (++quietSamples > idleAfter) {
+                reverbIdle = true;
+                filterL.reset();
+                filterR.reset();
+                oversampler.reset();
+            }
+        } else {
+            quietSamples = 0;
         }
 
         // Apply drive and filter based on routing mode
         auto applyDrive = [&](float& sampleL, float& sampleR) {
-            sampleL = std::tanh(sampleL * driveGain);
-            sampleR = std::tanh(sampleR * driveGain);
+            simd::float_4 buffer[Oversampler<simd::float_4>::MAX_FACTOR];
+            oversampler.upsample(simd::float_4(sampleL, sampleR, 0.f, 0.f), buffer);
+            for (int i = 0; i < oversampler.factor; i++) {
+                buffer[i][0] = std::tanh(buffer[i][0] * driveGain);
+                buffer[i][1] = std::tanh(buffer[i][1] * driveGain);
+            }
+            simd::float_4 out = oversampler.downsample(buffer);
+            sampleL = out[0];
+            sampleR = out[1];
         };
 
         auto applyFilter = [&](float& sampleL, float& sampleR) {
@@ -342,6 +480,20 @@ struct DriveVerbWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(27.94, 112)), module, DriveVerb::LEFT_OUTPUT));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(38.10, 112)), module, DriveVerb::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        DriveVerb* module = getModule<DriveVerb>();
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createIndexSubmenuItem("Drive oversampling", {"Off", "2x", "4x", "8x"},
+            [=]() { int factor = module->requestedOversampling; return (size_t)(factor >= 8 ? 3 : factor / 2); },
+            [=](size_t index) { module->setOversampling(1 << index); }
+        ));
+        menu->addChild(createIndexSubmenuItem("Reverb core", {"Freeverb", "Modulated FDN"},
+            [=]() { return (size_t)module->reverbCore; },
+            [=](size_t index) { module->reverbCore = (int)index; }
+        ));
+    }
 };
 
 Model* modelDriveVerb = createModel<DriveVerb, DriveVerbWidget>("DriveVerb");
@@ -0,0 +1,248 @@
+#pragma once
+#include <rack.hpp>
+#include "Denormals.hpp"
+#include "DelayResample.hpp"
+
+using namespace rack;
+
+// Normalized 8x8 Hadamard transform of two float_4 halves, as butterflies
+inline void hadamard8(simd::float_4& a, simd::float_4& b) {
+    using simd::float_4;
+    const float_4 pairSign(1.f, -1.f, 1.f, -1.f);
+    const float_4 halfSign(1.f, 1.f, -1.f, -1.f);
+
+    // Adjacent pairs, then pairs two apart, within each half
+    a = float_4(_mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(2, 3, 0, 1))) + a * pairSign;
+    b = float_4(_mm_shuffle_ps(b.v, b.v, _MM_SHUFFLE(2, 3, 0, 1))) + b * pairSign;
+    a = float_4(_mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(1, 0, 3, 2))) + a * halfSign;
+    b = float_4(_mm_shuffle_ps(b.v, b.v, _MM_SHUFFLE(1, 0, 3, 2))) + b * halfSign;
+
+    // Across halves, scaled by 1/sqrt(8) to stay lossless
+    float_4 sum = (a + b) * 0.35355339f;
+    b = (a - b) * 0.35355339f;
+    a = sum;
+}
+
+// Schroeder allpass on a power-of-two buffer, used to diffuse the input
+// before it enters the delay network
+struct DiffusionAllpass {
+    static const int BUFFER_SIZE = 2048;  // Longest stage at 192 kHz
+    static const int MASK = BUFFER_SIZE - 1;
+    float buffer[BUFFER_SIZE] = {};
+    int writePos = 0;
+    int delay = 1;
+    float gain = 0.6f;
+
+    float process(float input) {
+        float delayed = buffer[(writePos - delay) & MASK];
+        float v = input - gain * delayed;
+        buffer[writePos] = v + ANTI_DENORMAL;
+        writePos = (writePos + 1) & MASK;
+        return delayed + gain * v;
+    }
+
+    // Keeps the stored signal across a sample rate change; the caller sets
+    // the new delay
+    void resample(float ratio) {
+        resampleHistory(buffer, MASK, writePos, BUFFER_SIZE, BUFFER_SIZE, ratio);
+    }
+
+    void clear() {
+        std::fill(std::begin(buffer), std::end(buffer), 0.f);
+    }
+};
+
+// 8-line feedback delay network reverb with modulated delays.
+// The input passes two diffusion allpasses per channel, then feeds the eight
+// lines, which are mixed back through a Hadamard matrix two float_4 halves at
+// a time. Each line has a one-pole damping filter and a gain setting its
+// decay to the requested RT60. Delay reads are fractional and swept by slow
+// triangle LFOs of different rates, which breaks up the metallic ringing of
+// fixed lengths. Lines are power-of-two buffers indexed with a mask, so size
+// changes glide the read positions instead of resizing anything.
+struct ModulatedFDN {
+    static const int LINES = 8;
+    static const int BUFFER_SIZE = 16384;  // Holds size 1.25x at 192 kHz
+    static const int MASK = BUFFER_SIZE - 1;
+
+    // Mutually prime line lengths at 44.1 kHz, size 1x
+    const float baseLength[LINES] = {887, 1031, 1229, 1433, 1597, 1801, 2003, 2251};
+    // Input diffusion, left then right
+    const float diffuserLength[4] = {210, 562, 159, 410};
+    // Sweep depth in samples at 44.1 kHz
+    const float modDepth = 6.f;
+    // Roughly matches the Freeverb core's level
+    const float outputGain = 1.5f;
+
+    float buffer[LINES][BUFFER_SIZE] = {};
+    int writePos = 0;
+    DiffusionAllpass diffuserL[2];
+    DiffusionAllpass diffuserR[2];
+
+    // Lines 0-3 in the A vectors, 4-7 in the B vectors
+    simd::float_4 delayA = 0.f, delayB = 0.f;
+    simd::float_4 targetA = 0.f, targetB = 0.f;
+    simd::float_4 gainA = 0.f, gainB = 0.f;
+    simd::float_4 dampStateA = 0.f, dampStateB = 0.f;
+    simd::float_4 lfoPhaseA = simd::float_4(0.f, 0.25f, 0.5f, 0.75f);
+    simd::float_4 lfoPhaseB = simd::float_4(0.125f, 0.375f, 0.625f, 0.875f);
+    simd::float_4 lfoIncA = 0.f, lfoIncB = 0.f;
+    float damp = 0.5f;
+    float depth = 6.f;
+    float glide = 1.f;
+    bool primed = false;
+
+    float lastSize = -1.f;
+    float lastDecay = -1.f;
+    float lastSampleRate = -1.f;
+
+    // size in [0, 1] scales the lines 0.5x to 1.25x, decay is the RT60 in
+    // seconds and damp is the Freeverb-style one-pole damping amount. Only
+    // recomputes when size, decay or sample rate have changed.
+    void setParams(float size, float decay, float damping, float sampleRate) {
+        damp = damping;
+        if (size == lastSize && decay == lastDecay && sampleRate == lastSampleRate) return;
+
+        using simd::float_4;
+        float ratio = sampleRate / 44100.f;
+        if (sampleRate != lastSampleRate) {
+            for (int i = 0; i < 2; i++) {
+                diffuserL[i].delay = clamp((int)(diffuserLength[i] * ratio), 1, DiffusionAllpass::MASK);
+                diffuserR[i].delay = clamp((int)(diffuserLength[i + 2] * ratio), 1, DiffusionAllpass::MASK);
+            }
+            depth = modDepth * ratio;
+            // Rates between 0.5 and 1.1 Hz
+            lfoIncA = float_4(0.5f, 0.67f, 0.83f, 1.1f) / sampleRate;
+            lfoIncB = float_4(0.59f, 0.76f, 0.97f, 0.53f) / sampleRate;
+            // Size changes glide with a 100 ms time constant
+            glide = 1.f - std::exp(-1.f / (0.1f * sampleRate));
+        }
+        lastSize = size;
+        lastDecay = decay;
+        lastSampleRate = sampleRate;
+
+        float scale = (0.5f + 0.75f * size) * ratio;
+        float maxDelay = (float)(BUFFER_SIZE - 2) - depth;
+        alignas(16) float target[LINES];
+        alignas(16) float gain[LINES];
+        for (int i = 0; i < LINES; i++) {
+            target[i] = clamp(baseLength[i] * scale, depth + 1.f, maxDelay);
+            // -60 dB after `decay` seconds
+            gain[i] = std::pow(10.f, -3.f * target[i] / (decay * sampleRate));
+        }
+        targetA = float_4::load(&target[0]);
+        targetB = float_4::load(&target[4]);
+        gainA = float_4::load(&gain[0]);
+        gainB = float_4::load(&gain[4]);
+        if (!primed) {
+            delayA = targetA;
+            delayB = targetB;
+            primed = true;
+        }
+    }
+
+    // Triangle in [-1, 1]
+    static simd::float_4 triangle(simd::float_4 phase) {
+        return 4.f * simd::abs(phase - 0.5f) - 1.f;
+    }
+
+    void process(float inL, float inR, float& outL, float& outR) {
+        using simd::float_4;
+
+        lfoPhaseA += lfoIncA;
+        lfoPhaseB += lfoIncB;
+        lfoPhaseA -= simd::ifelse(lfoPhaseA >= 1.f, 1.f, 0.f);
+        lfoPhaseB -= simd::ifelse(lfoPhaseB >= 1.f, 1.f, 0.f);
+        delayA += glide * (targetA - delayA);
+        delayB += glide * (targetB - delayB);
+
+        alignas(16) float readDelay[LINES];
+        (delayA + depth * triangle(lfoPhaseA)).store(&readDelay[0]);
+        (delayB + depth * triangle(lfoPhaseB)).store(&readDelay[4]);
+
+        // Linear interpolation between the two samples around each read point
+        alignas(16) float tap[LINES];
+        for (int i = 0; i < LINES; i++) {
+            int whole = (int)readDelay[i];
+            float frac = readDelay[i] - whole;
+            int readPos = writePos - whole;
+            float x0 = buffer[i][readPos & MASK];
+            float x1 = buffer[i][(readPos - 1) & MASK];
+            tap[i] = x0 + frac * (x1 - x0);
+        }
+
+        float_4 a = float_4::load(&tap[0]);
+        float_4 b = float_4::load(&tap[4]);
+        dampStateA = a + damp * (dampStateA - a) + ANTI_DENORMAL;
+        dampStateB = b + damp * (dampStateB - b) + ANTI_DENORMAL;
+        a = dampStateA * gainA;
+        b = dampStateB * gainB;
+
+        // Left from the first four lines, right from the last four
+        outL = (a[0] - a[1] + a[2] - a[3]) * outputGain;
+        outR = (b[0] - b[1] + b[2] - b[3]) * outputGain;
+
+        float diffusedL = diffuserL[1].process(diffuserL[0].process(inL));
+        float diffusedR = diffuserR[1].process(diffuserR[0].process(inR));
+
+        hadamard8(a, b);
+        a += diffusedL * 0.5f;
+        b += diffusedR * 0.5f;
+        a.store(&tap[0]);
+        b.store(&tap[4]);
+
+        for (int i = 0; i < LINES; i++) {
+            buffer[i][writePos] = tap[i];
+        }
+        writePos = (writePos + 1) & MASK;
+    }
+
+    // Carries the running tail over to a new sample rate: every line is
+    // re-timed in place and the read positions are scaled to match, so
+    // nothing is cleared and the next setParams() finds the delays already
+    // at their targets. A network that has not run yet has nothing to keep.
+    void resample(float sampleRate) {
+        if (!primed || sampleRate == lastSampleRate) return;
+        float ratio = sampleRate / lastSampleRate;
+
+        // Only the span the reads can reach is re-timed, the rest is zeroed.
+        // Its length sets the effective ratio, within a sample of the exact
+        // one, which keeps resampleHistory() safe in place.
+        float reach = depth;
+        for (int i = 0; i < 4; i++) {
+            reach = std::max(reach, std::max(delayA[i], delayB[i]) + depth);
+        }
+        int oldUsed = std::min((int)reach + 4, (int)BUFFER_SIZE);
+        oldUsed = std::min(oldUsed, (int)(BUFFER_SIZE / ratio));
+        int newUsed = (int)(oldUsed * ratio);
+        int start = (writePos - oldUsed) & MASK;
+        writePos = (start + newUsed) & MASK;
+        int unused = BUFFER_SIZE - newUsed;
+        int unusedToEnd = std::min(unused, BUFFER_SIZE - writePos);
+        for (int i = 0; i < LINES; i++) {
+            resampleHistory(buffer[i], MASK, start, oldUsed, newUsed, (float)newUsed / oldUsed);
+            std::fill(buffer[i] + writePos, buffer[i] + writePos + unusedToEnd, 0.f);
+            std::fill(buffer[i], buffer[i] + (unused - unusedToEnd), 0.f);
+        }
+        for (int i = 0; i < 2; i++) {
+            diffuserL[i].resample(ratio);
+            diffuserR[i].resample(ratio);
+        }
+        delayA *= ratio;
+        delayB *= ratio;
+    }
+
+    void clear() {
+        memset(buffer, 0, sizeof(buffer));
+        for (int i = 0; i < 2; i++) {
+            diffuserL[i].clear();
+            diffuserR[i].clear();
+        }
+        dampStateA = 0.f;
+        dampStateB = 0.f;
+        // Nothing to glide from, so the next setParams() jumps straight to
+        // the targets
+        primed = false;
+        lastSize = -1.f;
+    }
+};
@@ -1,4 +1,6 @@
 #include "plugin.hpp"
+#include "NoiseBank.hpp"
+#include "Denormals.hpp"
 
 // Bandpass filter for tom/clap tones
 struct BiquadBandpass {
@@ -22,7 +24,7 @@ struct BiquadBandpass {
     }
 
     float process(float x) {
-        float y = a0 * x + a1 * x1 + a2 * x2 - b1 * y1 - b2 * y2;
+        float y = a0 * x + a1 * x1 + a2 * x2 - b1 * y1 - b2 * y2 + ANTI_DENORMAL;
         x2 = x1;
         x1 = x;
         y2 = y1;
@@ -142,12 +144,9 @@ struct ClapVoice {
         decayStart = (int)(sampleRate * 0.030f);
     }
 
-    float process(float level, float tone, float sampleRate) {
+    float process(float level, float tone, float sampleRate, float noise) {
         if (!active) return 0.0f;
 
-        // White noise
-        float noise = random::uniform() * 2.0f - 1.0f;
-
         // Bandpass filter (1-3kHz range)
         float freq = 1000.0f + tone * 2000.0f;
         filter.setParams(freq, 3.0f, sampleRate);
@@ -202,7 +201,7 @@ struct HiHatVoice {
         active = false;
     }
 
-    float process(float level, float decay, float sampleRate) {
+    float process(float level, float decay, float sampleRate, float noise) {
         if (!active) return 0.0f;
 
         // 6 detuned square wave oscillators (808 hat frequencies)
@@ -218,9 +217,6 @@ struct HiHatVoice {
             mixed += sq / 6.0f;
         }
 
-        // High-pass filtered noise
-        float noise = random::uniform() * 2.0f - 1.0f;
-
         // Bandpass at high frequencies
         filter.setParams(8000.0f, 2.0f, sampleRate);
         float filteredMix = filter.process(mixed + noise * 0.5f);
@@ -263,6 +259,13 @@ struct Drum808 : Module {
         CLAP_TRIG_INPUT,
         CLOSEDHAT_TRIG_INPUT,
         OPENHAT_TRIG_INPUT,
+        KICK_VEL_INPUT,
+        LOWTOM_VEL_INPUT,
+        MIDTOM_VEL_INPUT,
+        CLAP_VEL_INPUT,
+        CLOSEDHAT_VEL_INPUT,
+        OPENHAT_VEL_INPUT,
+        ACCENT_INPUT,
         INPUTS_LEN
     };
     enum OutputId {
@@ -292,6 +295,10 @@ struct Drum808 : Module {
     ClapVoice clap;
     HiHatVoice closedHat, openHat;
 
+    // One decorrelated noise stream per noisy voice
+    enum NoiseStream { CLAP_NOISE, CLOSEDHAT_NOISE, OPENHAT_NOISE, NOISE_STREAMS };
+    NoiseBank<NOISE_STREAMS> noise;
+
     // Triggers
     dsp::SchmittTrigger kickTrig, lowTomTrig, midTomTrig, clapTrig, closedHatTrig, openHatTrig;
 
@@ -327,6 +334,14 @@ struct Drum808 : Module {
         configInput(CLOSEDHAT_TRIG_INPUT, "Closed Hat Trigger");
         configInput(OPENHAT_TRIG_INPUT, "Open Hat Trigger");
 
+        configInput(KICK_VEL_INPUT, "Kick Velocity");
+        configInput(LOWTOM_VEL_INPUT, "Low Tom Velocity");
+        configInput(MIDTOM_VEL_INPUT, "Mid Tom Velocity");
+        configInput(CLAP_VEL_INPUT, "Clap Velocity");
+        configInput(CLOSEDHAT_VEL_INPUT, "Closed Hat Velocity");
+        configInput(OPENHAT_VEL_INPUT, "Open Hat Velocity");
+        configInput(ACCENT_INPUT, "Accent");
+
         configOutput(MAIN_LEFT_OUTPUT, "Main Left");
         configOutput(MAIN_RIGHT_OUTPUT, "Main Right");
         configOutput(KICK_OUTPUT, "Kick");
@@ -337,7 +352,17 @@ struct Drum808 : Module {
         configOutput(OPENHAT_OUTPUT, "Open Hat");
     }
 
+    // Velocity (0-10V, unpatched = full) and accent (up to +50%) are sampled at
+    // the trigger edge and folded into the voice's velocity gain
+    float triggerGain(int velInput) {
+        float vel = clamp(inputs[velInput].getNormalVoltage(10.0f) / 10.0f, 0.0f, 1.0f);
+        float accent = clamp(inputs[ACCENT_INPUT].getVoltage() / 10.0f, 0.0f, 1.0f);
+        return vel * (1.0f + 0.5f * accent);
+    }
+
     void process(const ProcessArgs& args) override {
+        DenormalGuard denormalGuard;
+
         float sampleRate = args.sampleRate;
 
         // Get parameters
@@ -356,39 +381,40 @@ struct Drum808 : Module {
 
         // Check triggers
         if (kickTrig.process(inputs[KICK_TRIG_INPUT].getVoltage(), 0.1f, 2.0f)) {
-            kick.trigger(1.0f);
+            kick.trigger(triggerGain(KICK_VEL_INPUT));
             kickLight = 1.0f;
         }
         if (lowTomTrig.process(inputs[LOWTOM_TRIG_INPUT].getVoltage(), 0.1f, 2.0f)) {
-            lowTom.trigger(1.0f, 110.0f);  // Low Tom at A2
+            lowTom.trigger(triggerGain(LOWTOM_VEL_INPUT), 110.0f);  // Low Tom at A2
             lowTomLight = 1.0f;
         }
         if (midTomTrig.process(inputs[MIDTOM_TRIG_INPUT].getVoltage(), 0.1f, 2.0f)) {
-            midTom.trigger(1.0f, 165.0f);  // Mid Tom at E3
+            midTom.trigger(triggerGain(MIDTOM_VEL_INPUT), 165.0f);  // Mid Tom at E3
             midTomLight = 1.0f;
         }
         if (clapTrig.process(inputs[CLAP_TRIG_INPUT].getVoltage(), 0.1f, 2.0f)) {
-            clap.trigger(1.0f, sampleRate);
+            clap.trigger(triggerGain(CLAP_VEL_INPUT), sampleRate);
             clapLight = 1.0f;
         }
         if (closedHatTrig.process(inputs[CLOSEDHAT_TRIG_INPUT].getVoltage(), 0.1f, 2.0f)) {
             // Closed hat chokes open hat
             openHat.choke();
-            closedHat.trigger(1.0f);
+            closedHat.trigger(triggerGain(CLOSEDHAT_VEL_INPUT));
             closedHatLight = 1.0f;
         }
         if (openHatTrig.process(inputs[OPENHAT_TRIG_INPUT].getVoltage(), 0.1f, 2.0f)) {
-            openHat.trigger(1.0f);
+            openHat.trigger(triggerGain(OPENHAT_VEL_INPUT));
             openHatLight = 1.0f;
         }
 
         // Process voices
+        noise.step();
         float kickOut = kick.process(kickLevel, kickDecay, sampleRate);
         float lowTomOut = lowTom.process(lowTomLevel, lowTomDecay, sampleRate);
         float midTomOut = midTom.process(midTomLevel, midTomDecay, sampleRate);
-        float clapOut = clap.process(clapLevel, clapTone, sampleRate);
-        float closedHatOut = closedHat.process(closedHatLevel, closedHatDecay, sampleRate);
-        float openHatOut = openHat.process(openHatLevel, openHatDecay, sampleRate);
+        float clapOut = clap.process(clapLevel, clapTone, sampleRate, noise.getWhite(CLAP_NOISE));
+        float closedHatOut = closedHat.process(closedHatLevel, closedHatDecay, sampleRate, noise.getWhite(CLOSEDHAT_NOISE));
+        float openHatOut = openHat.process(openHatLevel, openHatDecay, sampleRate, noise.getWhite(OPENHAT_NOISE));
 
         // Mix all voices
         float mix = kickOut + lowTomOut + midTomOut + clapOut + closedHatOut + openHatOut;
@@ -438,13 +464,14 @@ struct Drum808Widget : ModuleWidget {
 
         // 24HP = 121.92mm
         // Layout: 6 rows for 6 voices
-        // Each row: Light, Trig, Level, Decay, IndivOut
+        // Each row: Light, Trig, Vel, Level, Decay, IndivOut
 
-        float col1 = 10.0f;   // Light
-        float col2 = 22.0f;   // Trigger
-        float col3 = 38.0f;   // Level knob
-        float col4 = 58.0f;   // Decay/Tone knob
-        float col5 = 74.0f;   // Individual output
+        float col1 = 6.0f;    // Light
+        float col2 = 16.0f;   // Trigger
+        float colV = 27.0f;   // Velocity CV
+        float col3 = 40.0f;   // Level knob
+        float col4 = 56.0f;   // Decay/Tone knob
+        float col5 = 72.0f;   // Individual output
 
         float rowHeight = 15.0f;
         float startY = 28.0f;
@@ -453,6 +480,7 @@ struct Drum808Widget : ModuleWidget {
         float y = startY;
         addChild(createLightCentered<SmallLight<RedLight>>(mm2px(Vec(col1, y)), module, Drum808::KICK_LIGHT));
         addInput(createInputCentered<PJ301MPort>(mm2px(Vec(col2, y)), module, Drum808::KICK_TRIG_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(colV, y)), module, Drum808::KICK_VEL_INPUT));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col3, y)), module, Drum808::KICK_LEVEL_PARAM));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col4, y)), module, Drum808::KICK_DECAY_PARAM));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(col5, y)), module, Drum808::KICK_OUTPUT));
@@ -461,6 +489,7 @@ struct Drum808Widget : ModuleWidget {
         y += rowHeight;
         addChild(createLightCentered<SmallLight<YellowLight>>(mm2px(Vec(col1, y)), module, Drum808::LOWTOM_LIGHT));
         addInput(createInputCentered<PJ301MPort>(mm2px(Vec(col2, y)), module, Drum808::LOWTOM_TRIG_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(colV, y)), module, Drum808::LOWTOM_VEL_INPUT));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col3, y)), module, Drum808::LOWTOM_LEVEL_PARAM));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col4, y)), module, Drum808::LOWTOM_DECAY_PARAM));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(col5, y)), module, Drum808::LOWTOM_OUTPUT));
@@ -469,6 +498,7 @@ struct Drum808Widget : ModuleWidget {
         y += rowHeight;
         addChild(createLightCentered<SmallLight<GreenLight>>(mm2px(Vec(col1, y)), module, Drum808::MIDTOM_LIGHT));
         addInput(createInputCentered<PJ301MPort>(mm2px(Vec(col2, y)), module, Drum808::MIDTOM_TRIG_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(colV, y)), module, Drum808::MIDTOM_VEL_INPUT));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col3, y)), module, Drum808::MIDTOM_LEVEL_PARAM));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col4, y)), module, Drum808::MIDTOM_DECAY_PARAM));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(col5, y)), module, Drum808::MIDTOM_OUTPUT));
@@ -477,6 +507,7 @@ struct Drum808Widget : ModuleWidget {
         y += rowHeight;
         addChild(createLightCentered<SmallLight<GreenLight>>(mm2px(Vec(col1, y)), module, Drum808::CLAP_LIGHT));
         addInput(createInputCentered<PJ301MPort>(mm2px(Vec(col2, y)), module, Drum808::CLAP_TRIG_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(colV, y)), module, Drum808::CLAP_VEL_INPUT));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col3, y)), module, Drum808::CLAP_LEVEL_PARAM));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col4, y)), module, Drum808::CLAP_TONE_PARAM));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(col5, y)), module, Drum808::CLAP_OUTPUT));
@@ -485,6 +516,7 @@ struct Drum808Widget : ModuleWidget {
         y += rowHeight;
         addChild(createLightCentered<SmallLight<WhiteLight>>(mm2px(Vec(col1, y)), module, Drum808::CLOSEDHAT_LIGHT));
         addInput(createInputCentered<PJ301MPort>(mm2px(Vec(col2, y)), module, Drum808::CLOSEDHAT_TRIG_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(colV, y)), module, Drum808::CLOSEDHAT_VEL_INPUT));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col3, y)), module, Drum808::CLOSEDHAT_LEVEL_PARAM));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col4, y)), module, Drum808::CLOSEDHAT_DECAY_PARAM));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(col5, y)), module, Drum808::CLOSEDHAT_OUTPUT));
@@ -493,12 +525,14 @@ struct Drum808Widget : ModuleWidget {
         y += rowHeight;
         addChild(createLightCentered<SmallLight<BlueLight>>(mm2px(Vec(col1, y)), module, Drum808::OPENHAT_LIGHT));
         addInput(createInputCentered<PJ301MPort>(mm2px(Vec(col2, y)), module, Drum808::OPENHAT_TRIG_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(colV, y)), module, Drum808::OPENHAT_VEL_INPUT));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col3, y)), module, Drum808::OPENHAT_LEVEL_PARAM));
         addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col4, y)), module, Drum808::OPENHAT_DECAY_PARAM));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(col5, y)), module, Drum808::OPENHAT_OUTPUT));
 
         // Main outputs at bottom
         float outY = 118.0f;
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(10.0f, outY)), module, Drum808::ACCENT_INPUT));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(30.0f, outY)), module, Drum808::MAIN_LEFT_OUTPUT));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(50.0f, outY)), module, Drum808::MAIN_RIGHT_OUTPUT));
     }
@@ -1,4 +1,16 @@
 #include "plugin.hpp"
+#include "NoiseBank.hpp"
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#if defined ARCH_WIN
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#endif
 
 // Generic drum voice that can be randomized
 struct DrumVoice {
@@ -71,6 +83,20 @@ struct DrumVoice {
         }
     }
 
+    // Voices whose noise is at most a short click sound the same on every hit
+    // and can be pre-rendered; noise-heavy types stay on live synthesis
+    bool isCacheable() const {
+        switch (type) {
+            case KICK:
+            case TOM:
+                return true;
+            case PERC:
+                return noiseAmount < 0.05f;
+            default:
+                return false;
+        }
+    }
+
     void trigger(float vel) {
         active = true;
         velocity = vel;
@@ -80,7 +106,7 @@ struct DrumVoice {
         filterY1 = 0.0f;
     }
 
-    float process(float level, float character, float sampleRate) {
+    float process(float level, float character, float sampleRate, float noise) {
         if (!active) return 0.0f;
 
         float output = 0.0f;
@@ -98,9 +124,9 @@ struct DrumVoice {
                 float tone = std::sin(2.0f * M_PI * phase);
 
                 // Optional noise click
-                float noise = (random::uniform() * 2.0f - 1.0f) * std::exp(-time / 0.005f);
+                float click = noise * std::exp(-time / 0.005f);
 
-                output = tone * (1.0f - noiseAmount) + noise * noiseAmount;
+                output = tone * (1.0f - noiseAmount) + click * noiseAmount;
                 break;
             }
             case SNARE: {
@@ -111,7 +137,6 @@ struct DrumVoice {
                 if (phase >= 1.0f) phase -= 1.0f;
                 float tone = std::sin(2.0f * M_PI * phase);
 
-                float noise = random::uniform() * 2.0f - 1.0f;
                 // Highpass filter on noise
                 filterY1 = filterCoef * noise + (1.0f - filterCoef) * filterY1;
                 float hpNoise = noise - filterY1;
@@ -141,13 +166,12 @@ struct DrumVoice {
                 phase += freq / sampleRate;
                 if (phase >= 1.0f) phase -= 1.0f;
                 float tone = std::sin(2.0f * M_PI * phase);
-                float noise = (random::uniform() * 2.0f - 1.0f) * std::exp(-time / 0.01f);
-                output = tone + noise * noiseAmount;
+                float click = noise * std::exp(-time / 0.01f);
+                output = tone + click * noiseAmount;
                 break;
             }
             case CLAP: {
                 // Filtered noise with multi-attack
-                float noise = random::uniform() * 2.0f - 1.0f;
                 // Bandpass-ish
                 filterY1 = 0.1f * noise + 0.9f * filterY1;
                 float bp = noise - filterY1;
@@ -166,7 +190,6 @@ struct DrumVoice {
             }
             case RIM: {
                 // Short click
-                float noise = random::uniform() * 2.0f - 1.0f;
                 phase += baseFreq / sampleRate;
                 if (phase >= 1.0f) phase -= 1.0f;
                 float tone = std::sin(2.0f * M_PI * phase);
@@ -182,13 +205,11 @@ struct DrumVoice {
                 // FM modulation
                 float mod = std::sin(4.0f * M_PI * phase) * std::exp(-time / 0.02f);
                 float tone = std::sin(2.0f * M_PI * phase + mod * 2.0f);
-                float noise = (random::uniform() * 2.0f - 1.0f);
                 output = tone * (1.0f - noiseAmount) + noise * noiseAmount;
                 break;
             }
             case NOISE: {
                 // Pure filtered noise
-                float noise = random::uniform() * 2.0f - 1.0f;
                 filterY1 = filterCoef * noise + (1.0f - filterCoef) * filterY1;
                 output = noise - filterY1;
                 break;
@@ -208,6 +229,104 @@ struct DrumVoice {
     }
 };
 
+// One-shot render of a voice at full level and velocity
+struct DrumCache {
+    std::vector<float> samples;
+    uint32_t generation = 0;
+    float character = 0.0f;
+    float sampleRate = 0.0f;
+};
+
+struct RenderRequest {
+    DrumVoice voice;
+    uint32_t generation = 0;
+    float character = 0.0f;
+    float sampleRate = 0.0f;
+};
+
+// Cached playback for one voice. The audio thread owns the playback state and
+// hands requests/retired buffers to the render worker through single-slot
+// atomics, so it never allocates, frees or locks.
+struct CachedPlayer {
+    static const int FADE_LEN = 256;
+
+    std::atomic<bool> requestPending{false};
+    RenderRequest request;  // Written by audio only while !requestPending
+    std::atomic<DrumCache*> incoming{nullptr};  // Worker -> audio
+    std::atomic<DrumCache*> retired{nullptr};   // Audio -> worker, freed there
+
+    DrumCache* current = nullptr;
+    DrumCache* fading = nullptr;  // Outgoing cache during a hot-swap
+    int pos = 0;
+    int fadeRemaining = 0;
+    float velocity = 1.0f;
+    bool playing = false;
+
+    ~CachedPlayer() {
+        delete current;
+        delete fading;
+        delete incoming.load();
+        delete retired.load();
+    }
+
+    // Adopt a freshly rendered cache, crossfading if a hit is still sounding
+    void poll() {
+        if (fading || retired.load(std::memory_order_acquire)) return;
+        DrumCache* next = incoming.exchange(nullptr, std::memory_order_acq_rel);
+        if (!next) return;
+        if (playing && current) {
+            fading = current;
+            fadeRemaining = FADE_LEN;
+        } else if (current) {
+            retired.store(current, std::memory_order_release);
+        }
+        current = next;
+    }
+
+    bool canPlay(uint32_t generation, float sampleRate) const {
+        return current && current->generation == generation && current->sampleRate == sampleRate;
+    }
+
+    void trigger(float vel) {
+        playing = true;
+        velocity = vel;
+        pos = 0;
+    }
+
+    // Stops playback, handing back a cache that was still fading out.
+    // poll() only sets fading while the retired slot is empty, so it is free.
+    void stop() {
+        playing = false;
+        if (fading) {
+            retired.store(fading, std::memory_order_release);
+            fading = nullptr;
+        }
+    }
+
+    static float sampleAt(const DrumCache* cache, int i) {
+        return i < (int)cache->samples.size() ? cache->samples[i] : 0.0f;
+    }
+
+    float process() {
+        if (!playing) return 0.0f;
+
+        float out = sampleAt(current, pos);
+        if (fading) {
+            float t = (float)fadeRemaining / FADE_LEN;
+            out += (sampleAt(fading, pos) - out) * t;
+            if (--fadeRemaining <= 0) {
+                retired.store(fading, std::memory_order_release);
+                fading = nullptr;
+            }
+        }
+
+        pos++;
+        if (!fading && pos >= (int)current->samples.size()) playing = false;
+
+        return out * velocity;
+    }
+};
+
 struct DrumRoulette : Module {
     enum ParamId {
         LEVEL_1_PARAM, LEVEL_2_PARAM, LEVEL_3_PARAM, LEVEL_4_PARAM,
@@ -220,6 +339,9 @@ struct DrumRoulette : Module {
         TRIG_1_INPUT, TRIG_2_INPUT, TRIG_3_INPUT, TRIG_4_INPUT,
         TRIG_5_INPUT, TRIG_6_INPUT, TRIG_7_INPUT, TRIG_8_INPUT,
         RAND_INPUT,
+        VEL_1_INPUT, VEL_2_INPUT, VEL_3_INPUT, VEL_4_INPUT,
+        VEL_5_INPUT, VEL_6_INPUT, VEL_7_INPUT, VEL_8_INPUT,
+        ACCENT_INPUT,
         INPUTS_LEN
     };
     enum OutputId {
@@ -237,11 +359,28 @@ struct DrumRoulette : Module {
     };
 
     DrumVoice voices[8];
+    NoiseBank<8> noise;  // One decorrelated stream per voice
     dsp::SchmittTrigger triggers[8];
     dsp::SchmittTrigger randTrigger;
     float lightValues[8] = {0.0f};
     float randLight = 0.0f;
 
+    // Cached playback: deterministic voices are rendered on a background
+    // thread whenever their parameters change and played back from memory
+    bool cachedPlayback = false;
+    CachedPlayer players[8];
+    uint32_t voiceGeneration[8] = {};
+    uint32_t requestedGeneration[8] = {};
+    float requestedCharacter[8] = {};
+    float requestedSampleRate[8] = {};
+    int cacheCheckCounter = 0;
+
+    std::thread renderThread;
+    std::mutex renderMutex;
+    std::condition_variable renderCv;
+    bool renderRunning = false;
+    NoiseBank<1> renderNoise;  // Only touched by the render thread
+
     DrumRoulette() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -261,6 +400,7 @@ struct DrumRoulette : Module {
             configParam(CHAR_1_PARAM + i, 0.0f, 1.0f, 0.5f,
                         std::string(names[i]) + " Character", "%", 0.0f, 100.0f);
             configInput(TRIG_1_INPUT + i, std::string(names[i]) + " Trigger");
+            configInput(VEL_1_INPUT + i, std::string(names[i]) + " Velocity");
             configOutput(OUT_1_OUTPUT + i, std::string(names[i]) + " Output");
         }
 
@@ -268,36 +408,181 @@ struct DrumRoulette : Module {
         voices[3].ampDecay = 0.2f;
 
         configInput(RAND_INPUT, "Randomize All Trigger");
+        configInput(ACCENT_INPUT, "Accent");
         configOutput(MAIN_LEFT_OUTPUT, "Main Left");
         configOutput(MAIN_RIGHT_OUTPUT, "Main Right");
     }
 
+    ~DrumRoulette() {
+        stopRenderThread();
+    }
+
+    void setCachedPlayback(bool enabled) {
+        cachedPlayback = enabled;
+        if (enabled) startRenderThread();
+    }
+
+    void startRenderThread() {
+        if (renderRunning) return;
+        renderRunning = true;
+        renderThread = std::thread([this] { renderLoop(); });
+    }
+
+    void stopRenderThread() {
+        if (!renderRunning) return;
+        {
+            std::lock_guard<std::mutex> lock(renderMutex);
+            renderRunning = false;
+        }
+        renderCv.notify_one();
+        renderThread.join();
+    }
+
+    // Rendering is never urgent (the live voice covers until a cache is
+    // ready), so keep the worker out of the way of the engine threads
+    static void lowerThreadPriority() {
+#if defined ARCH_WIN
+        SetThreadPriority(GetCurrentThread(), THREAD_PRIORITY_BELOW_NORMAL);
+#elif defined SCHED_IDLE
+        sched_param param = {};
+        pthread_setschedparam(pthread_self(), SCHED_IDLE, &param);
+#else
+        sched_param param = {};
+        param.sched_priority = sched_get_priority_min(SCHED_OTHER);
+        pthread_setschedparam(pthread_self(), SCHED_OTHER, &param);
+#endif
+    }
+
+    // The audio thread never signals the worker; it polls at a low rate instead
+    void renderLoop() {
+        lowerThreadPriority();
+        std::unique_lock<std::mutex> lock(renderMutex);
+        while (renderRunning) {
+            renderCv.wait_for(lock, std::chrono::milliseconds(20));
+            if (!renderRunning) break;
+
+            for (int i = 0; i < 8; i++) {
+                CachedPlayer& player = players[i];
+                delete player.retired.exchange(nullptr, std::memory_order_acq_rel);
+
+                if (!player.requestPending.load(std::memory_order_acquire)) continue;
+                RenderRequest request = player.request;
+                player.requestPending.store(false, std::memory_order_release);
+
+                DrumCache* cache = renderVoice(request);
+                delete player.incoming.exchange(cache, std::memory_order_acq_rel);
+            }
+        }
+    }
+
+    DrumCache* renderVoice(RenderRequest& request) {
+        DrumCache* cache = new DrumCache;
+        cache->generation = request.generation;
+        cache->character = request.character;
+        cache->sampleRate = request.sampleRate;
+
+        // Same start state as trigger(), with fixed phases
+        DrumVoice& voice = request.voice;
+        voice.active = true;
+        voice.velocity = 1.0f;
+        voice.time = 0.0f;
+        voice.phase = 0.0f;
+        voice.filterY1 = 0.0f;
+
+        // Envelope reaches -60dB after ln(1000) time constants
+        float decay = voice.ampDecay * (0.5f + request.character);
+        size_t length = (size_t)(decay * 6.91f * request.sampleRate) + 1;
+        cache->samples.reserve(length);
+        while (voice.active && cache->samples.size() < length) {
+            renderNoise.step();
+            cache->samples.push_back(voice.process(1.0f, request.character, request.sampleRate, renderNoise.getWhite(0)));
+        }
+        return cache;
+    }
+
+    // Queue a render for every cacheable voice whose cache is out of date
+    void updateCaches(float sampleRate) {
+        for (int i = 0; i < 8; i++) {
+            players[i].poll();
+
+            if (!voices[i].isCacheable()) continue;
+            float character = params[CHAR_1_PARAM + i].getValue();
+            bool stale = requestedGeneration[i] != voiceGeneration[i]
+                || requestedSampleRate[i] != sampleRate
+                || std::abs(requestedCharacter[i] - character) > 0.005f;
+            if (!stale || players[i].requestPending.load(std::memory_order_acquire)) continue;
+
+            players[i].request.voice = voices[i];
+            players[i].request.generation = voiceGeneration[i];
+            players[i].request.character = character;
+            players[i].request.sampleRate = sampleRate;
+            players[i].requestPending.store(true, std::memory_order_release);
+
+            requestedGeneration[i] = voiceGeneration[i];
+            requestedCharacter[i] = character;
+            requestedSampleRate[i] = sampleRate;
+        }
+    }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = json_object();
+        json_object_set_new(rootJ, "cachedPlayback", json_boolean(cachedPlayback));
+        return rootJ;
+    }
+
+    void dataFromJson(json_t* rootJ) override {
+        json_t* cachedJ = json_object_get(rootJ, "cachedPlayback");
+        if (cachedJ) setCachedPlayback(json_boolean_value(cachedJ));
+    }
+
     void process(const ProcessArgs& args) override {
         // Check randomize trigger
         if (randTrigger.process(inputs[RAND_INPUT].getVoltage(), 0.1f, 2.0f)) {
             for (int i = 0; i < 8; i++) {
                 voices[i].randomize();
+                voiceGeneration[i]++;
             }
             randLight = 1.0f;
         }
 
+        if (cachedPlayback && ++cacheCheckCounter >= 64) {
+            cacheCheckCounter = 0;
+            updateCaches(args.sampleRate);
+        }
+
+        // Accent is shared by all voices, so read it once per frame
+        float accent = clamp(inputs[ACCENT_INPUT].getVoltage() / 10.0f, 0.0f, 1.0f);
+        float accentGain = 1.0f + 0.5f * accent;
+
         float mix = 0.0f;
+        noise.step();
 
         for (int i = 0; i < 8; i++) {
             // Check voice triggers
             if (triggers[i].process(inputs[TRIG_1_INPUT + i].getVoltage(), 0.1f, 2.0f)) {
                 // Closed hat (2) chokes open hat (3)
-                if (i == 2 && voices[3].active) {
+                if (i == 2) {
                     voices[3].active = false;
+                    players[3].stop();
+                }
+                // Velocity is sampled at the edge and folded into the voice gain
+                float vel = clamp(inputs[VEL_1_INPUT + i].getNormalVoltage(10.0f) / 10.0f, 0.0f, 1.0f);
+                if (cachedPlayback && voices[i].isCacheable()
+                    && players[i].canPlay(voiceGeneration[i], args.sampleRate)) {
+                    voices[i].active = false;
+                    players[i].trigger(vel * accentGain);
+                } else {
+                    players[i].stop();
+                    voices[i].trigger(vel * accentGain);
                 }
-                voices[i].trigger(1.0f);
                 lightValues[i] = 1.0f;
             }
 
             // Process voice
             float level = params[LEVEL_1_PARAM + i].getValue();
             float character = params[CHAR_1_PARAM + i].getValue();
-            float out = voices[i].process(level, character, args.sampleRate);
+            float out = voices[i].process(level, character, args.sampleRate, noise.getWhite(i));
+            out += players[i].process() * level;
 
             // Individual output
             outputs[OUT_1_OUTPUT + i].setVoltage(out * 5.0f);
@@ -336,11 +621,12 @@ struct DrumRouletteWidget : ModuleWidget {
         // 20HP = 101.6mm
         // 8 rows for voices plus randomize section
 
-        float col1 = 10.0f;   // Light
-        float col2 = 22.0f;   // Trigger
-        float col3 = 38.0f;   // Level knob
-        float col4 = 54.0f;   // Character knob
-        float col5 = 70.0f;   // Individual output
+        float col1 = 6.0f;    // Light
+        float col2 = 16.0f;   // Trigger
+        float colV = 27.0f;   // Velocity CV
+        float col3 = 40.0f;   // Level knob
+        float col4 = 56.0f;   // Character knob
+        float col5 = 72.0f;   // Individual output
 
         float rowHeight = 11.0f;
         float startY = 24.0f;
@@ -350,6 +636,7 @@ struct DrumRouletteWidget : ModuleWidget {
             float y = startY + i * rowHeight;
             addChild(createLightCentered<SmallLight<GreenLight>>(mm2px(Vec(col1, y)), module, DrumRoulette::LIGHT_1 + i));
             addInput(createInputCentered<PJ301MPort>(mm2px(Vec(col2, y)), module, DrumRoulette::TRIG_1_INPUT + i));
+            addInput(createInputCentered<PJ301MPort>(mm2px(Vec(colV, y)), module, DrumRoulette::VEL_1_INPUT + i));
             addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col3, y)), module, DrumRoulette::LEVEL_1_PARAM + i));
             addParam(createParamCentered<RoundSmallBlackKnob>(mm2px(Vec(col4, y)), module, DrumRoulette::CHAR_1_PARAM + i));
             addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(col5, y)), module, DrumRoulette::OUT_1_OUTPUT + i));
@@ -357,13 +644,24 @@ struct DrumRouletteWidget : ModuleWidget {
 
         // Randomize section
         float randY = 115.0f;
-        addChild(createLightCentered<MediumLight<RedLight>>(mm2px(Vec(15.0f, randY)), module, DrumRoulette::RAND_LIGHT));
-        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(30.0f, randY)), module, DrumRoulette::RAND_INPUT));
+        addChild(createLightCentered<MediumLight<RedLight>>(mm2px(Vec(8.0f, randY)), module, DrumRoulette::RAND_LIGHT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(20.0f, randY)), module, DrumRoulette::RAND_INPUT));
+        addInput(createInputCentered<PJ301MPort>(mm2px(Vec(36.0f, randY)), module, DrumRoulette::ACCENT_INPUT));
 
         // Main outputs
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(55.0f, randY)), module, DrumRoulette::MAIN_LEFT_OUTPUT));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(70.0f, randY)), module, DrumRoulette::MAIN_RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        DrumRoulette* module = getModule<DrumRoulette>();
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createBoolMenuItem("Cached playback", "",
+            [=]() { return module->cachedPlayback; },
+            [=](bool enabled) { module->setCachedPlayback(enabled); }
+        ));
+    }
 };
 
 Model* modelDrumRoulette = createModel<DrumRoulette, DrumRouletteWidget>("DrumRoulette");
@@ -0,0 +1,40 @@
+#pragma once
+#include <rack.hpp>
+
+using namespace rack;
+
+// Re-times the contents of a delay line after a sample rate change, so a
+// running tail keeps its pitch and place in time instead of being cleared.
+// The history is read oldest-first from buffer[(start + k) & mask] for k in
+// [0, oldLength), newest last, and rewritten in place from the same start as
+// newLength samples at `ratio` = new rate / old rate, by linear
+// interpolation. The buffer size must be a power of two (mask + 1) at least
+// as long as either length. Anything more than a sample older than the old
+// history reads as silence. Works without a scratch buffer: the pass runs in whichever
+// direction keeps every read at or ahead of the sample being overwritten,
+// which holds whenever the lengths are equal or ratio == newLength / oldLength.
+inline void resampleHistory(float* buffer, int mask, int start, int oldLength, int newLength, float ratio) {
+    if (oldLength == newLength && ratio == 1.f) return;
+
+    // Position in the old history of new sample j
+    float newest = (float)(oldLength - 1);
+    float step = 1.f / ratio;
+    auto sampleAt = [&](int j) {
+        float p = newest - (newLength - 1 - j) * step;
+        // Less than a sample past the oldest one still reads it, since a line
+        // reads its oldest sample next
+        if (p <= -1.f) return 0.f;
+        p = std::max(p, 0.f);
+        int i = (int)p;
+        float frac = p - i;
+        float x0 = buffer[(start + i) & mask];
+        float x1 = (i + 1 < oldLength) ? buffer[(start + i + 1) & mask] : x0;
+        return x0 + frac * (x1 - x0);
+    };
+
+    if (newest - (newLength - 1) * step > 0.f) {
+        for (int j = 0; j < newLength; j++) buffer[(start + j) & mask] = sampleAt(j);
+    } else {
+        for (int j = newLength - 1; j >= 0; j--) buffer[(start + j) & mask] = sampleAt(j);
+    }
+}
@@ -1,4 +1,7 @@
 #include "plugin.hpp"
+#include "Denormals.hpp"
+#include "DelayResample.hpp"
+#include "ModulatedFDN.hpp"
 
 // Reuse comb/allpass/biquad from DriveVerb pattern
 struct CombFilter {
@@ -12,10 +15,21 @@ struct CombFilter {
 
     void setSize(int newSize) { size = clamp(newSize, 1, MAX_SIZE - 1); }
 
+    // Changes the length keeping the stored tail, stretched to fit
+    void resize(int newSize) {
+        newSize = clamp(newSize, 1, MAX_SIZE - 1);
+        // The line wraps at size, so bring the oldest sample to the front
+        std::rotate(buffer, buffer + writePos, buffer + size);
+        resampleHistory(buffer, MAX_SIZE - 1, 0, size, newSize, (float)newSize / size);
+        size = newSize;
+        writePos = 0;
+    }
+
     float process(float input) {
-        int readPos = (writePos - size + MAX_SIZE) % size;
+        // The oldest sample in the ring, written exactly size samples ago
+        int readPos = writePos;
         float output = buffer[readPos];
-        filterStore = (output * (1.f - damp)) + (filterStore * damp);
+        filterStore = (output * (1.f - damp)) + (filterStore * damp) + ANTI_DENORMAL;
         buffer[writePos] = input + (filterStore * feedback);
         writePos = (writePos + 1) % size;
         return output;
@@ -36,11 +50,22 @@ struct AllpassFilter {
 
     void setSize(int newSize) { size = clamp(newSize, 1, MAX_SIZE - 1); }
 
+    // Changes the length keeping the stored tail, stretched to fit
+    void resize(int newSize) {
+        newSize = clamp(newSize, 1, MAX_SIZE - 1);
+        // The line wraps at size, so bring the oldest sample to the front
+        std::rotate(buffer, buffer + writePos, buffer + size);
+        resampleHistory(buffer, MAX_SIZE - 1, 0, size, newSize, (float)newSize / size);
+        size = newSize;
+        writePos = 0;
+    }
+
     float process(float input) {
-        int readPos = (writePos - size + MAX_SIZE) % size;
+        // The oldest sample in the ring, written exactly size samples ago
+        int readPos = writePos;
         float bufOut = buffer[readPos];
         float output = -input + bufOut;
-        buffer[writePos] = input + (bufOut * feedback);
+        buffer[writePos] = input + (bufOut * feedback) + ANTI_DENORMAL;
         writePos = (writePos + 1) % size;
         return output;
     }
@@ -68,6 +93,11 @@ struct ModulationDelay {
         writePos = (writePos + 1) % MAX_SIZE;
     }
 
+    // Keeps the stored signal across a sample rate change
+    void resample(float ratio) {
+        resampleHistory(buffer, MAX_SIZE - 1, writePos, MAX_SIZE, MAX_SIZE, ratio);
+    }
+
     void clear() { std::fill(std::begin(buffer), std::end(buffer), 0.f); }
 };
 
@@ -102,7 +132,7 @@ struct BiquadFilter {
     }
 
     float process(float input) {
-        float temp = input - b1 * z1 - b2 * z2;
+        float temp = input - b1 * z1 - b2 * z2 + ANTI_DENORMAL;
         float output = a0 * temp + a1 * z1 + a2 * z2;
         z2 = z1;
         z1 = temp;
@@ -132,6 +162,12 @@ struct FlutterVerb : Module {
     const int allpassTunings[4] = {556, 441, 341, 225};
     const int stereoSpread = 23;
 
+    // Alternative core: modulated 8-line FDN, selected from the context menu
+    enum ReverbCore { FREEVERB_CORE, FDN_CORE };
+    int reverbCore = FREEVERB_CORE;
+    int activeCore = FREEVERB_CORE;
+    ModulatedFDN fdn;
+
     // Modulation
     ModulationDelay modDelayL, modDelayR;
     float wowPhaseL = 0.f, wowPhaseR = 0.f;
@@ -141,6 +177,18 @@ struct FlutterVerb : Module {
     BiquadFilter filterL, filterR;
     bool previousWasLowPass = false;
 
+    // Idling: at mix 0 the reverb input is muted. Once the reverb output has
+    // stayed below SILENCE with nothing feeding it for longer than the combs,
+    // allpasses and modulation delay can hold a sample, the reverb (and in
+    // Wet Only mode the effects after it) stops until it is needed again.
+    static constexpr float SILENCE = 1e-6f;  // -120 dB
+    int quietSamples = 0;
+    int idleAfter = ModulationDelay::MAX_SIZE;
+    bool reverbIdle = false;
+
+    // Rate the modulation delay contents were recorded at
+    float lastSampleRate = 0.f;
+
     FlutterVerb() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
         configParam(SIZE_PARAM, 0.f, 100.f, 50.f, "Size", "%");
@@ -171,22 +219,46 @@ struct FlutterVerb : Module {
         }
     }
 
+    // Tails survive a rate change: the delay lines are re-timed in place
+    // instead of cleared, without allocating (see DriveVerb)
     void onSampleRateChange() override {
-        float ratio = APP->engine->getSampleRate() / 44100.f;
+        float sampleRate = APP->engine->getSampleRate();
+        float ratio = sampleRate / 44100.f;
         for (int i = 0; i < 8; i++) {
-            combL[i].setSize(static_cast<int>(combTunings[i] * ratio));
-            combR[i].setSize(static_cast<int>((combTunings[i] + stereoSpread) * ratio));
-            combL[i].clear(); combR[i].clear();
+            combL[i].resize(static_cast<int>(combTunings[i] * ratio));
+            combR[i].resize(static_cast<int>((combTunings[i] + stereoSpread) * ratio));
         }
         for (int i = 0; i < 4; i++) {
-            allpassL[i].setSize(static_cast<int>(allpassTunings[i] * ratio));
-            allpassR[i].setSize(static_cast<int>((allpassTunings[i] + stereoSpread) * ratio));
-            allpassL[i].clear(); allpassR[i].clear();
+            allpassL[i].resize(static_cast<int>(allpassTunings[i] * ratio));
+            allpassR[i].resize(static_cast<int>((allpassTunings[i] + stereoSpread) * ratio));
+        }
+        if (activeCore == FDN_CORE) fdn.resample(sampleRate);
+        if (lastSampleRate > 0.f) {
+            modDelayL.resample(sampleRate / lastSampleRate);
+            modDelayR.resample(sampleRate / lastSampleRate);
         }
-        modDelayL.clear(); modDelayR.clear();
+        lastSampleRate = sampleRate;
+
+        // Longer than the longest comb or FDN line plus the allpass chain,
+        // and than the modulation delay
+        idleAfter = std::max(static_cast<int>(4096 * ratio), (int)ModulationDelay::MAX_SIZE);
+        quietSamples = 0;
+    }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = json_object();
+        json_object_set_new(rootJ, "reverbCore", json_integer(reverbCore));
+        return rootJ;
+    }
+
+    void dataFromJson(json_t* rootJ) override {
+        json_t* reverbCoreJ = json_object_get(rootJ, "reverbCore");
+        if (reverbCoreJ) reverbCore = clamp((int)json_integer_value(reverbCoreJ), 0, 1);
     }
 
     void process(const ProcessArgs& args) override {
+        DenormalGuard denormalGuard;
+
         float size = params[SIZE_PARAM].getValue() / 100.f;
         float decay = params[DECAY_PARAM].getValue();
         float mix = params[MIX_PARAM].getValue();
@@ -204,10 +276,6 @@ struct FlutterVerb : Module {
         // Reverb params
         float feedback = clamp(0.5f + (decay / 20.f), 0.5f, 0.98f);
         float damp = clamp(0.5f - (size * 0.3f), 0.1f, 0.7f);
-        for (int i = 0; i < 8; i++) {
-            combL[i].feedback = combR[i].feedback = feedback;
-            combL[i].damp = combR[i].damp = damp;
-        }
 
         // Get inputs
         float inputL = inputs[LEFT_INPUT].getVoltage() / 5.f;
@@ -282,23 +350,67 @@ struct FlutterVerb : Module {
             dryL = inputL; dryR = inputR;
         }
 
-        // Reverb
-        float wetL = 0.f, wetR = 0.f;
-        for (int i = 0; i < 8; i++) {
-            wetL += combL[i].process(inputL);
-            wetR += combR[i].process(inputR);
+        // The wet signal is inaudible at mix 0, so let the tail run out
+        if (mix <= 0.f) {
+            inputL = inputR = 0.f;
         }
-        wetL /= 8.f; wetR /= 8.f;
-        for (int i = 0; i < 4; i++) {
-            wetL = allpassL[i].process(wetL);
-            wetR = allpassR[i].process(wetR);
+        bool silentInput = std::abs(inputL) < SILENCE && std::abs(inputR) < SILENCE;
+        if (reverbIdle && !silentInput) {
+            reverbIdle = false;
+            quietSamples = 0;
         }
 
-        // Wet-only mode: apply effects after reverb
-        if (!wetDryMode) {
-            applyModulation(wetL, wetR);
-            applyDrive(wetL, wetR);
-            applyTone(wetL, wetR);
+        // The core being switched in starts from silence
+        if (reverbCore != activeCore) {
+            activeCore = reverbCore;
+            if (activeCore == FDN_CORE) {
+                fdn.clear();
+            } else {
+                for (int i = 0; i < 8; i++) { combL[i].clear(); combR[i].clear(); }
+                for (int i = 0; i < 4; i++) { allpassL[i].clear(); allpassR[i].clear(); }
+            }
+        }
+
+        // Reverb
+        float wetL = 0.f, wetR = 0.f;
+        if (!reverbIdle) {
+            if (activeCore == FDN_CORE) {
+                // Decay is the RT60 here rather than a comb feedback amount
+                fdn.setParams(size, decay, damp, args.sampleRate);
+                fdn.process(inputL, inputR, wetL, wetR);
+            } else {
+                for (int i = 0; i < 8; i++) {
+                    combL[i].feedback = combR[i].feedback = feedback;
+                    combL[i].damp = combR[i].damp = damp;
+                    wetL += combL[i].process(inputL);
+                    wetR += combR[i].process(inputR);
+                }
+                wetL /= 8.f; wetR /= 8.f;
+                for (int i = 0; i < 4; i++) {
+                    wetL = allpassL[i].process(wetL);
+                    wetR = allpassR[i].process(wetR);
+                }
+            }
+
+            // Go idle once the tail has died away
+            if (silentInput && std::abs(wetL) < SILENCE && std::abs(wetR) < SILENCE) {
+                if (++quietSamples > idleAfter) {
+                    reverbIdle = true;
+                    if (!wetDryMode) {
+                        filterL.reset();
+                        filterR.reset();
+                    }
+                }
+            } else {
+                quietSamples = 0;
+            }
+
+            // Wet-only mode: apply effects after reverb
+            if (!wetDryMode) {
+                applyModulation(wetL, wetR);
+                applyDrive(wetL, wetR);
+                applyTone(wetL, wetR);
+            }
         }
 
         // Mix
@@ -335,6 +447,16 @@ struct FlutterVerbWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(34, 112)), module, FlutterVerb::LEFT_OUTPUT));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(46, 112)), module, FlutterVerb::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        FlutterVerb* module = getModule<FlutterVerb>();
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createIndexSubmenuItem("Reverb core", {"Freeverb", "Modulated FDN"},
+            [=]() { return (size_t)module->reverbCore; },
+            [=](size_t index) { module->reverbCore = (int)index; }
+        ));
+    }
 };
 
 Model* modelFlutterVerb = createModel<FlutterVerb, FlutterVerbWidget>("FlutterVerb");
@@ -1,65 +1,78 @@
 #include "plugin.hpp"
+#include "Denormals.hpp"
+
+using simd::float_4;
+
+// Biquad filter over four channels, one lane per channel.
+// Coefficients and state are stored transposed (one vector per coefficient),
+// so every channel can sit at its own cutoff and filter type.
+struct BiquadFilter4 {
+    float_4 b0 = 1.f, b1 = 0.f, b2 = 0.f;
+    float_4 a1 = 0.f, a2 = 0.f;
+    float_4 z1 = 0.f, z2 = 0.f;
+
+    // Clear the state of the lanes set in mask
+    void reset(float_4 mask) {
+        z1 = simd::ifelse(mask, 0.f, z1);
+        z2 = simd::ifelse(mask, 0.f, z2);
+    }
 
-// Simple biquad filter implementation
-struct BiquadFilter {
-    float a0 = 1.f, a1 = 0.f, a2 = 0.f;
-    float b1 = 0.f, b2 = 0.f;
-    float z1 = 0.f, z2 = 0.f;
+    // Low-pass lanes where isLowPass is set, high-pass elsewhere
+    void setCoefficients(float_4 isLowPass, float_4 cutoff, float sampleRate, float Q) {
+        float_4 w0 = 2.f * M_PI * cutoff / sampleRate;
+        float_4 cosw0 = simd::cos(w0);
+        float_4 sinw0 = simd::sin(w0);
+        float_4 alpha = sinw0 / (2.f * Q);
+        float_4 norm = 1.f / (1.f + alpha);
+
+        float_4 lowEdge = (1.f - cosw0) * norm;
+        float_4 highEdge = (1.f + cosw0) * norm;
+        b0 = simd::ifelse(isLowPass, lowEdge, highEdge) * 0.5f;
+        b1 = simd::ifelse(isLowPass, lowEdge, -highEdge);
+        b2 = b0;
+        a1 = -2.f * cosw0 * norm;
+        a2 = (1.f - alpha) * norm;
+    }
 
-    void reset() {
-        z1 = z2 = 0.f;
+    // Direct Form II Transposed
+    float_4 process(float_4 input) {
+        float_4 output = b0 * input + z1;
+        z1 = b1 * input - a1 * output + z2 + ANTI_DENORMAL;
+        z2 = b2 * input - a2 * output;
+        return output;
     }
+};
 
-    void setLowPass(float sampleRate, float cutoff, float Q) {
-        float w0 = 2.f * M_PI * cutoff / sampleRate;
-        float cosw0 = std::cos(w0);
-        float sinw0 = std::sin(w0);
-        float alpha = sinw0 / (2.f * Q);
-
-        float b0 = (1.f - cosw0) / 2.f;
-        float b1_coef = 1.f - cosw0;
-        float b2_coef = (1.f - cosw0) / 2.f;
-        float a0_coef = 1.f + alpha;
-        float a1_coef = -2.f * cosw0;
-        float a2_coef = 1.f - alpha;
-
-        // Normalize coefficients
-        a0 = b0 / a0_coef;
-        a1 = b1_coef / a0_coef;
-        a2 = b2_coef / a0_coef;
-        b1 = a1_coef / a0_coef;
-        b2 = a2_coef / a0_coef;
+// Constant-power pan law (cos/sin of a quarter turn) tabulated over pan
+// positions -1 to +1, built once on first use
+struct PanTable {
+    static const int SIZE = 256;
+
+    float left[SIZE + 1];
+    float right[SIZE + 1];
+
+    PanTable() {
+        for (int i = 0; i <= SIZE; i++) {
+            float panRadians = (float)i / SIZE * 0.5f * M_PI;
+            left[i] = std::cos(panRadians);
+            right[i] = std::sin(panRadians);
+        }
     }
 
-    void setHighPass(float sampleRate, float cutoff, float Q) {
-        float w0 = 2.f * M_PI * cutoff / sampleRate;
-        float cosw0 = std::cos(w0);
-        float sinw0 = std::sin(w0);
-        float alpha = sinw0 / (2.f * Q);
-
-        float b0 = (1.f + cosw0) / 2.f;
-        float b1_coef = -(1.f + cosw0);
-        float b2_coef = (1.f + cosw0) / 2.f;
-        float a0_coef = 1.f + alpha;
-        float a1_coef = -2.f * cosw0;
-        float a2_coef = 1.f - alpha;
-
-        // Normalize coefficients
-        a0 = b0 / a0_coef;
-        a1 = b1_coef / a0_coef;
-        a2 = b2_coef / a0_coef;
-        b1 = a1_coef / a0_coef;
-        b2 = a2_coef / a0_coef;
+    static const PanTable& get() {
+        static PanTable table;
+        return table;
     }
 
-    float process(float input) {
-        float output = a0 * input + a1 * z1 + a2 * z2 - b1 * z1 - b2 * z2;
-        // Direct Form II Transposed
-        float temp = input - b1 * z1 - b2 * z2;
-        output = a0 * temp + a1 * z1 + a2 * z2;
-        z2 = z1;
-        z1 = temp;
-        return output;
+    // pan in [-1, 1]
+    void lookup(float_4 pan, float_4& leftGain, float_4& rightGain) const {
+        float_4 index = (pan + 1.f) * (0.5f * SIZE);
+        for (int i = 0; i < 4; i++) {
+            int j = clamp((int)index[i], 0, SIZE - 1);
+            float frac = index[i] - j;
+            leftGain[i] = left[j] + frac * (left[j + 1] - left[j]);
+            rightGain[i] = right[j] + frac * (right[j + 1] - right[j]);
+        }
     }
 };
 
@@ -87,11 +100,25 @@ struct GainKnob : Module {
         LIGHTS_LEN
     };
 
-    // Per-channel filter state
-    BiquadFilter filterL;
-    BiquadFilter filterR;
-    bool previousWasLowPass = false;
-    float lastFilterPercent = 0.f;
+    // Each polyphony channel is an independent strip; four strips per group
+    BiquadFilter4 filterL[4];
+    BiquadFilter4 filterR[4];
+    float_4 filterActive[4] = {};
+    float_4 lastFilterPercent[4] = {};
+    bool filterDirty = true;
+    bool filterEngaged = false;  // Any strip outside the dead zone
+
+    // Settings are read every CONTROL_INTERVAL samples; the left/right gains
+    // then ramp linearly to their new targets over the next interval
+    static const int CONTROL_INTERVAL = 32;
+    int controlCounter = 0;
+    int rampRemaining = 0;
+    float_4 leftGain[4] = {};
+    float_4 rightGain[4] = {};
+    float_4 leftTarget[4] = {};
+    float_4 rightTarget[4] = {};
+    float_4 leftStep[4] = {};
+    float_4 rightStep[4] = {};
 
     GainKnob() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -121,95 +148,129 @@ struct GainKnob : Module {
         configBypass(RIGHT_INPUT, RIGHT_OUTPUT);
     }
 
+    void onSampleRateChange() override {
+        filterDirty = true;
+    }
+
     void process(const ProcessArgs& args) override {
-        // Read parameters with CV modulation
-        float gainDb = params[GAIN_PARAM].getValue();
-        if (inputs[GAIN_CV_INPUT].isConnected()) {
-            // ±5V CV adds ±30dB
-            gainDb += inputs[GAIN_CV_INPUT].getVoltage() * 6.f;
-            gainDb = clamp(gainDb, -60.f, 0.f);
-        }
+        DenormalGuard denormalGuard;
 
-        float panPercent = params[PAN_PARAM].getValue();
-        if (inputs[PAN_CV_INPUT].isConnected()) {
-            // ±5V CV adds ±100%
-            panPercent += inputs[PAN_CV_INPUT].getVoltage() * 20.f;
-            panPercent = clamp(panPercent, -100.f, 100.f);
-        }
+        int channels = std::max(1, std::max(inputs[LEFT_INPUT].getChannels(), inputs[RIGHT_INPUT].getChannels()));
 
-        float filterPercent = params[FILTER_PARAM].getValue();
-        if (inputs[FILTER_CV_INPUT].isConnected()) {
-            // ±5V CV adds ±100%
-            filterPercent += inputs[FILTER_CV_INPUT].getVoltage() * 20.f;
-            filterPercent = clamp(filterPercent, -100.f, 100.f);
+        if (controlCounter-- <= 0) {
+            controlCounter = CONTROL_INTERVAL - 1;
+            bool ramping = false;
+            filterEngaged = false;
+            for (int c = 0; c < channels; c += 4) {
+                ramping |= updateGroup(c / 4, c, args.sampleRate);
+                filterEngaged |= simd::movemask(filterActive[c / 4]) != 0;
+            }
+            filterDirty = false;
+            rampRemaining = ramping ? CONTROL_INTERVAL : 0;
         }
 
-        // Get input signals
-        float inputL = inputs[LEFT_INPUT].getVoltage();
-        float inputR = inputs[RIGHT_INPUT].isConnected() ?
-                       inputs[RIGHT_INPUT].getVoltage() : inputL;
-
-        // Apply DJ-style filter if not at center
-        float outputL = inputL;
-        float outputR = inputR;
-
-        if (std::abs(filterPercent) > 0.5f) {
-            bool isLowPass = (filterPercent < 0.f);
-
-            // Reset filter state when switching between low-pass and high-pass
-            if (isLowPass != previousWasLowPass) {
-                filterL.reset();
-                filterR.reset();
-            }
-            previousWasLowPass = isLowPass;
-
-            // Update filter coefficients
-            if (isLowPass) {
-                // Low-pass: -100% = 200Hz, 0% = 20kHz
-                float normalizedValue = std::abs(filterPercent) / 100.f;
-                float cutoffHz = 20000.f * std::pow(10.f, -normalizedValue * std::log10(20000.f / 200.f));
-                cutoffHz = clamp(cutoffHz, 200.f, 20000.f);
-                filterL.setLowPass(args.sampleRate, cutoffHz, 0.707f);
-                filterR.setLowPass(args.sampleRate, cutoffHz, 0.707f);
-            } else {
-                // High-pass: 0% = 20Hz, +100% = 10kHz
-                float normalizedValue = filterPercent / 100.f;
-                float cutoffHz = 20.f * std::pow(10.f, normalizedValue * std::log10(10000.f / 20.f));
-                cutoffHz = clamp(cutoffHz, 20.f, 10000.f);
-                filterL.setHighPass(args.sampleRate, cutoffHz, 0.707f);
-                filterR.setHighPass(args.sampleRate, cutoffHz, 0.707f);
+        if (!filterEngaged && rampRemaining == 0) {
+            // Neutral filter and settled gains: a plain scaled copy
+            bool stereoInput = inputs[RIGHT_INPUT].isConnected();
+            for (int c = 0; c < channels; c += 4) {
+                float_4 inputL = inputs[LEFT_INPUT].getPolyVoltageSimd<float_4>(c);
+                float_4 inputR = stereoInput ? inputs[RIGHT_INPUT].getPolyVoltageSimd<float_4>(c) : inputL;
+                outputs[LEFT_OUTPUT].setVoltageSimd(inputL * leftGain[c / 4], c);
+                outputs[RIGHT_OUTPUT].setVoltageSimd(inputR * rightGain[c / 4], c);
             }
-
-            outputL = filterL.process(inputL);
-            outputR = filterR.process(inputR);
         } else {
-            // Reset filter when entering bypass zone
-            if (std::abs(lastFilterPercent) > 0.5f) {
-                filterL.reset();
-                filterR.reset();
-                previousWasLowPass = false;
+            for (int c = 0; c < channels; c += 4) {
+                processGroup(c / 4, c);
+            }
+            if (rampRemaining > 0) {
+                rampRemaining--;
             }
         }
-        lastFilterPercent = filterPercent;
 
-        // Convert dB to linear gain
-        float gainLinear;
-        if (gainDb <= -59.9f) {
-            gainLinear = 0.f;
-        } else {
-            gainLinear = std::pow(10.f, gainDb / 20.f);
+        outputs[LEFT_OUTPUT].setChannels(channels);
+        outputs[RIGHT_OUTPUT].setChannels(channels);
+    }
+
+    // Control-rate update of one group of four strips. Returns true if its
+    // gains have to ramp.
+    bool updateGroup(int g, int c, float sampleRate) {
+        // Read parameters with CV modulation; mono CV applies to every strip
+        // ±5V CV adds ±30dB
+        float_4 gainDb = params[GAIN_PARAM].getValue() + inputs[GAIN_CV_INPUT].getPolyVoltageSimd<float_4>(c) * 6.f;
+        gainDb = simd::clamp(gainDb, -60.f, 0.f);
+
+        // ±5V CV adds ±100%
+        float_4 panPercent = params[PAN_PARAM].getValue() + inputs[PAN_CV_INPUT].getPolyVoltageSimd<float_4>(c) * 20.f;
+        panPercent = simd::clamp(panPercent, -100.f, 100.f);
+
+        // ±5V CV adds ±100%
+        float_4 filterPercent = params[FILTER_PARAM].getValue() + inputs[FILTER_CV_INPUT].getPolyVoltageSimd<float_4>(c) * 20.f;
+        filterPercent = simd::clamp(filterPercent, -100.f, 100.f);
+
+        // DJ-style filter on strips outside the centre dead zone
+        float_4 active = simd::abs(filterPercent) > 0.5f;
+        float_4 isLowPass = filterPercent < 0.f;
+        float_4 wasLowPass = lastFilterPercent[g] < 0.f;
+
+        // Reset filter state when entering or leaving the dead zone or when
+        // switching between low-pass and high-pass
+        float_4 resetMask = (filterActive[g] ^ active) | (active & (isLowPass ^ wasLowPass));
+        if (simd::movemask(resetMask)) {
+            filterL[g].reset(resetMask);
+            filterR[g].reset(resetMask);
         }
+        filterActive[g] = active;
+
+        // Coefficients only change with the settings
+        if (simd::movemask(active) && (filterDirty || simd::movemask(filterPercent != lastFilterPercent[g]))) {
+            // Low-pass: -100% = 200Hz, 0% = 20kHz
+            // High-pass: 0% = 20Hz, +100% = 10kHz
+            float_4 normalizedValue = simd::abs(filterPercent) / 100.f;
+            float_4 cutoffHz = simd::ifelse(isLowPass,
+                20000.f * simd::pow(10.f, -normalizedValue * std::log10(20000.f / 200.f)),
+                20.f * simd::pow(10.f, normalizedValue * std::log10(10000.f / 20.f)));
+            filterL[g].setCoefficients(isLowPass, cutoffHz, sampleRate, 0.707f);
+            filterR[g].setCoefficients(isLowPass, cutoffHz, sampleRate, 0.707f);
+        }
+        lastFilterPercent[g] = filterPercent;
+
+        // Convert dB to linear gain
+        float_4 gainLinear = simd::pow(10.f, gainDb / 20.f);
+        gainLinear = simd::ifelse(gainDb <= -59.9f, 0.f, gainLinear);
+
+        // The previous ramp has just finished; land exactly on its target so
+        // static settings stop ramping
+        leftGain[g] = leftTarget[g];
+        rightGain[g] = rightTarget[g];
+
+        // Constant-power pan coefficients
+        PanTable::get().lookup(panPercent / 100.f, leftTarget[g], rightTarget[g]);
+        leftTarget[g] *= gainLinear;
+        rightTarget[g] *= gainLinear;
+
+        leftStep[g] = (leftTarget[g] - leftGain[g]) * (1.f / CONTROL_INTERVAL);
+        rightStep[g] = (rightTarget[g] - rightGain[g]) * (1.f / CONTROL_INTERVAL);
+        return simd::movemask((leftStep[g] != 0.f) | (rightStep[g] != 0.f)) != 0;
+    }
 
-        // Calculate constant-power pan coefficients
-        float panNormalized = panPercent / 100.f; // -1.0 to +1.0
-        float panRadians = (panNormalized * 0.25f + 0.25f) * M_PI;
+    void processGroup(int g, int c) {
+        float_4 outputL = inputs[LEFT_INPUT].getPolyVoltageSimd<float_4>(c);
+        float_4 outputR = inputs[RIGHT_INPUT].isConnected() ?
+                          inputs[RIGHT_INPUT].getPolyVoltageSimd<float_4>(c) : outputL;
 
-        float leftGain = std::cos(panRadians) * gainLinear;
-        float rightGain = std::sin(panRadians) * gainLinear;
+        if (simd::movemask(filterActive[g])) {
+            outputL = simd::ifelse(filterActive[g], filterL[g].process(outputL), outputL);
+            outputR = simd::ifelse(filterActive[g], filterR[g].process(outputR), outputR);
+        }
+
+        if (rampRemaining > 0) {
+            leftGain[g] += leftStep[g];
+            rightGain[g] += rightStep[g];
+        }
 
         // Apply gain and pan
-        outputs[LEFT_OUTPUT].setVoltage(outputL * leftGain);
-        outputs[RIGHT_OUTPUT].setVoltage(outputR * rightGain);
+        outputs[LEFT_OUTPUT].setVoltageSimd(outputL * leftGain[g], c);
+        outputs[RIGHT_OUTPUT].setVoltageSimd(outputR * rightGain[g], c);
     }
 };
 
@@ -1,18 +1,8 @@
 #include "plugin.hpp"
-
-// PolyBLEP anti-aliasing function
-// t is phase position relative to discontinuity (t = phase / dt or (phase - 1) / dt)
-// dt is phase increment (freq * sampleTime)
-inline float polyBlep(float t, float dt) {
-    if (t < dt) {
-        t /= dt;
-        return t + t - t * t - 1.f;
-    } else if (t > 1.f - dt) {
-        t = (t - 1.f) / dt;
-        return t * t + t + t + 1.f;
-    }
-    return 0.f;
-}
+#include "NoiseBank.hpp"
+#include "GenesisOsc.hpp"
+#include "Oversampler.hpp"
+#include "SampleHold.hpp"
 
 struct GenesisMono : Module {
     enum ParamId {
@@ -47,8 +37,12 @@ struct GenesisMono : Module {
     float phase = 0.f;
     float fmPhase = 0.f;
     dsp::SchmittTrigger syncTrigger;
-    float heldSample = 0.f;
-    int holdCounter = 0;
+    FractionalHold sampleHold;  // Lane 0 only
+    bool bandlimitedHold = false;
+    NoiseBank<1> noise;
+    bool wavetables = false;  // Mipmapped tables instead of PolyBLEP
+    Oversampler<float> oversampler;  // Oscillators and bit crusher run at the high rate
+    int requestedOversampling = 1;  // Set from the menu, applied at the top of process()
 
     GenesisMono() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -72,43 +66,78 @@ struct GenesisMono : Module {
 
         // Configure output
         configOutput(AUDIO_OUTPUT, "Audio");
+
+        // Build the shared wavetables here rather than on the audio thread
+        WaveTables::get();
     }
 
-    // Helper function to generate waveform from phase
-    float generateWaveform(float p, int waveform, float pulseWidth, float dt) {
-        float output = 0.f;
-        switch (waveform) {
-            case 0: // Sine
-                output = std::sin(2.f * M_PI * p);
-                break;
-            case 1: // Triangle
-                output = 4.f * std::abs(p - 0.5f) - 1.f;
-                break;
-            case 2: // Saw (with PolyBLEP)
-                output = 2.f * p - 1.f;
-                output -= polyBlep(p, dt);
-                break;
-            case 3: // Square (with PolyBLEP)
-                output = p < 0.5f ? 1.f : -1.f;
-                output += polyBlep(p, dt);
-                output -= polyBlep(fmodf(p + 0.5f, 1.f), dt);
-                break;
-            case 4: // Pulse (with PolyBLEP)
-                output = p < pulseWidth ? 1.f : -1.f;
-                output += polyBlep(p, dt);
-                output -= polyBlep(fmodf(p + (1.f - pulseWidth), 1.f), dt);
-                break;
-            case 5: // Noise (white noise)
-                output = 2.f * random::uniform() - 1.f;
-                break;
-            default:
-                output = std::sin(2.f * M_PI * p);
-                break;
+    json_t* dataToJson() override {
+        json_t* rootJ = json_object();
+        json_object_set_new(rootJ, "wavetables", json_boolean(wavetables));
+        json_object_set_new(rootJ, "oversampling", json_integer(requestedOversampling));
+        json_object_set_new(rootJ, "bandlimitedHold", json_boolean(bandlimitedHold));
+        return rootJ;
+    }
+
+    void dataFromJson(json_t* rootJ) override {
+        json_t* wavetablesJ = json_object_get(rootJ, "wavetables");
+        if (wavetablesJ) wavetables = json_boolean_value(wavetablesJ);
+        json_t* oversamplingJ = json_object_get(rootJ, "oversampling");
+        if (oversamplingJ) setOversampling(json_integer_value(oversamplingJ));
+        json_t* bandlimitedHoldJ = json_object_get(rootJ, "bandlimitedHold");
+        if (bandlimitedHoldJ) bandlimitedHold = json_boolean_value(bandlimitedHoldJ);
+    }
+
+    // Only records the factor: the UI thread must not touch the oversampler
+    // while process() is running it
+    void setOversampling(int factor) {
+        requestedOversampling = (factor >= 8) ? 8 : (factor >= 4) ? 4 : (factor >= 2) ? 2 : 1;
+    }
+
+    // Modulator, carrier and bit crusher for one waveform kernel, run
+    // `oversampler.factor` times and decimated back to one sample
+    template <int SHAPE>
+    float generate(float dt, float fmDt, float fmAmount, float pulseWidth, float noiseSample, float levels) {
+        int factor = oversampler.factor;
+        float subDt = dt / factor;
+        float subFmDt = fmDt / factor;
+        float buffer[Oversampler<float>::MAX_FACTOR];
+
+        for (int i = 0; i < factor; i++) {
+            // Carrier phase accumulation
+            phase += subDt;
+            if (phase >= 1.f) {
+                phase -= 1.f;
+            }
+
+            // FM modulator oscillator (ratio-based frequency)
+            fmPhase += subFmDt;
+            if (fmPhase >= 1.f) {
+                fmPhase -= 1.f;
+            }
+
+            // Generate modulator output (uses same waveform type)
+            float modulatorOutput = oscSample<SHAPE>(fmPhase, subFmDt, pulseWidth, noiseSample);
+
+            // Apply phase modulation to carrier
+            float modulatedPhase = phase + modulatorOutput * fmAmount;
+            // Wrap modulated phase to [0, 1)
+            modulatedPhase = fmodf(modulatedPhase + 10.f, 1.f); // +10 ensures positive before fmod
+
+            // Generate carrier output with modulated phase
+            float output = oscSample<SHAPE>(modulatedPhase, subDt, pulseWidth, noiseSample);
+
+            // Quantize output (normalize to 0-1, quantize, denormalize)
+            float normalized = (output + 1.f) * 0.5f; // Map -1..1 to 0..1
+            float quantized = std::floor(normalized * levels) / levels;
+            buffer[i] = quantized * 2.f - 1.f; // Map 0..1 back to -1..1
         }
-        return output;
+        return oversampler.downsample(buffer);
     }
 
     void process(const ProcessArgs& args) override {
+        if (requestedOversampling != oversampler.factor) oversampler.setFactor(requestedOversampling);
+
         // --- Phase 2.1-2.3: Oscillator with PolyBLEP, FM Synthesis & Hard Sync ---
 
         // Read pitch CV and calculate frequency
@@ -135,30 +164,8 @@ struct GenesisMono : Module {
             phase = 0.f; // Reset carrier phase on rising edge
         }
 
-        // Carrier phase accumulation
-        phase += dt;
-        if (phase >= 1.f) {
-            phase -= 1.f;
-        }
-
-        // FM modulator oscillator (ratio-based frequency)
-        float fmFreq = freq * fmRatio;
-        float fmDt = fmFreq * args.sampleTime;
-        fmPhase += fmDt;
-        if (fmPhase >= 1.f) {
-            fmPhase -= 1.f;
-        }
-
-        // Generate modulator output (uses same waveform type)
-        float modulatorOutput = generateWaveform(fmPhase, waveform, pulseWidth, fmDt);
-
-        // Apply phase modulation to carrier
-        float modulatedPhase = phase + modulatorOutput * fmAmount;
-        // Wrap modulated phase to [0, 1)
-        modulatedPhase = fmodf(modulatedPhase + 10.f, 1.f); // +10 ensures positive before fmod
-
-        // Generate carrier output with modulated phase
-        float output = generateWaveform(modulatedPhase, waveform, pulseWidth, dt);
+        // FM modulator increment (ratio-based frequency)
+        float fmDt = freq * fmRatio * args.sampleTime;
 
         // --- Phase 2.4: Bit Crushing & Sample Rate Reduction ---
 
@@ -166,25 +173,32 @@ struct GenesisMono : Module {
         float bitDepth = params[BIT_DEPTH_PARAM].getValue();
         bitDepth += inputs[BITS_INPUT].getVoltage() * 1.6f; // 0-10V CV maps to 0-16 bits
         bitDepth = clamp(bitDepth, 1.f, 16.f);
-
-        // Quantize output (normalize to 0-1, quantize, denormalize)
         float levels = std::pow(2.f, bitDepth);
-        float normalized = (output + 1.f) * 0.5f; // Map -1..1 to 0..1
-        float quantized = std::floor(normalized * levels) / levels;
-        output = quantized * 2.f - 1.f; // Map 0..1 back to -1..1
+
+        // Noise sample shared by modulator and carrier
+        noise.step();
+        float noiseSample = noise.getWhite(0);
+
+        // Pick the waveform kernel once for both oscillators and all sub-samples
+        float output = 0.f;
+        switch (oscShape(waveform, wavetables)) {
+            case SHAPE_SINE: output = generate<SHAPE_SINE>(dt, fmDt, fmAmount, pulseWidth, noiseSample, levels); break;
+            case SHAPE_TRIANGLE: output = generate<SHAPE_TRIANGLE>(dt, fmDt, fmAmount, pulseWidth, noiseSample, levels); break;
+            case SHAPE_SAW_BLEP: output = generate<SHAPE_SAW_BLEP>(dt, fmDt, fmAmount, pulseWidth, noiseSample, levels); break;
+            case SHAPE_SQUARE_BLEP: output = generate<SHAPE_SQUARE_BLEP>(dt, fmDt, fmAmount, pulseWidth, noiseSample, levels); break;
+            case SHAPE_PULSE_BLEP: output = generate<SHAPE_PULSE_BLEP>(dt, fmDt, fmAmount, pulseWidth, noiseSample, levels); break;
+            case SHAPE_SAW_TABLE: output = generate<SHAPE_SAW_TABLE>(dt, fmDt, fmAmount, pulseWidth, noiseSample, levels); break;
+            case SHAPE_SQUARE_TABLE: output = generate<SHAPE_SQUARE_TABLE>(dt, fmDt, fmAmount, pulseWidth, noiseSample, levels); break;
+            case SHAPE_PULSE_TABLE: output = generate<SHAPE_PULSE_TABLE>(dt, fmDt, fmAmount, pulseWidth, noiseSample, levels); break;
+            case SHAPE_NOISE: output = generate<SHAPE_NOISE>(dt, fmDt, fmAmount, pulseWidth, noiseSample, levels); break;
+        }
 
         // Sample rate reduction
         float sampleRateParam = params[SAMPLE_RATE_PARAM].getValue();
         // Map 0.0-1.0 to ~1kHz to full sample rate
         float targetRate = 1000.f + (args.sampleRate - 1000.f) * sampleRateParam;
-        int holdFrames = std::max(1, static_cast<int>(args.sampleRate / targetRate));
-
-        holdCounter++;
-        if (holdCounter >= holdFrames) {
-            heldSample = output;
-            holdCounter = 0;
-        }
-        output = heldSample;
+        float holdRatio = std::min(1.f, targetRate / args.sampleRate);
+        output = sampleHold.process(output, holdRatio, bandlimitedHold)[0];
 
         // Apply level control
         float level = params[LEVEL_PARAM].getValue();
@@ -236,6 +250,24 @@ struct GenesisMonoWidget : ModuleWidget {
         // Add activity light (top center)
         addChild(createLightCentered<MediumLight<GreenLight>>(mm2px(Vec(20.32, 11.0)), module, GenesisMono::ACTIVE_LIGHT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        GenesisMono* module = getModule<GenesisMono>();
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createBoolMenuItem("Band-limited wavetables", "",
+            [=]() { return module->wavetables; },
+            [=](bool enabled) { module->wavetables = enabled; }
+        ));
+        menu->addChild(createIndexSubmenuItem("Oversampling", {"Off", "2x", "4x", "8x"},
+            [=]() { int factor = module->requestedOversampling; return (size_t)(factor >= 8 ? 3 : factor / 2); },
+            [=](size_t index) { module->setOversampling(1 << index); }
+        ));
+        menu->addChild(createBoolMenuItem("Band-limited sample rate reduction", "",
+            [=]() { return module->bandlimitedHold; },
+            [=](bool enabled) { module->bandlimitedHold = enabled; }
+        ));
+    }
 };
 
 // Create model at file scope
@@ -0,0 +1,163 @@
+#pragma once
+#include <rack.hpp>
+
+using namespace rack;
+
+// Oscillator kernels shared by GenesisMono and GenesisPoly.
+// Each waveform is a separate template specialization, so the modules pick
+// the kernel once per process() call instead of switching twice per sample.
+
+// PolyBLEP anti-aliasing function
+// t is phase position relative to discontinuity (t = phase / dt or (phase - 1) / dt)
+// dt is phase increment (freq * sampleTime)
+inline float polyBlep(float t, float dt) {
+    if (t < dt) {
+        t /= dt;
+        return t + t - t * t - 1.f;
+    } else if (t > 1.f - dt) {
+        t = (t - 1.f) / dt;
+        return t * t + t + t + 1.f;
+    }
+    return 0.f;
+}
+
+// Wrap a phase that is at most one cycle past 1
+inline float wrapPhase(float p) {
+    return p >= 1.f ? p - 1.f : p;
+}
+
+// Mipmapped band-limited saw tables plus a sine table, built once on first use.
+// Level l holds the first (1024 >> l) harmonics, so a table can always be
+// picked whose top harmonic stays below Nyquist for the current increment.
+struct WaveTables {
+    static const int SIZE = 2048;
+    static const int LEVELS = 11;
+
+    float saw[LEVELS][SIZE + 1];
+    float sine[SIZE + 1];
+
+    WaveTables() {
+        for (int i = 0; i <= SIZE; i++) {
+            sine[i] = std::sin(2.f * M_PI * i / SIZE);
+        }
+
+        // Build from the top level down, adding each level's extra harmonics
+        // to the previous one: 2p - 1 = -(2/pi) sum sin(2 pi k p) / k
+        std::vector<double> acc(SIZE + 1, 0.0);
+        int harmonics = 0;
+        for (int l = LEVELS - 1; l >= 0; l--) {
+            int top = 1024 >> l;
+            for (int k = harmonics + 1; k <= top; k++) {
+                for (int i = 0; i <= SIZE; i++) {
+                    acc[i] += std::sin(2.0 * M_PI * k * i / SIZE) / k;
+                }
+            }
+            harmonics = top;
+            for (int i = 0; i <= SIZE; i++) {
+                saw[l][i] = (float)(-2.0 / M_PI * acc[i]);
+            }
+        }
+    }
+
+    // The first call builds the tables (tens of milliseconds), so modules
+    // call this from their constructors, never first from process()
+    static const WaveTables& get() {
+        static WaveTables tables;
+        return tables;
+    }
+
+    static float lookup(const float* table, float p) {
+        float index = p * SIZE;
+        int i = clamp((int)index, 0, SIZE - 1);
+        float frac = index - i;
+        return table[i] + frac * (table[i + 1] - table[i]);
+    }
+
+    // Band-limited saw for phase p at increment dt
+    float sawAt(float p, float dt) const {
+        int e;
+        std::frexp(2048.f * dt, &e);
+        return lookup(saw[clamp(e, 0, LEVELS - 1)], p);
+    }
+};
+
+enum OscShape {
+    SHAPE_SINE,
+    SHAPE_TRIANGLE,
+    SHAPE_SAW_BLEP,
+    SHAPE_SQUARE_BLEP,
+    SHAPE_PULSE_BLEP,
+    SHAPE_SAW_TABLE,
+    SHAPE_SQUARE_TABLE,
+    SHAPE_PULSE_TABLE,
+    SHAPE_NOISE,
+};
+
+// Map the WAVE knob (0-5) and the wavetable option to a kernel
+inline int oscShape(int waveform, bool wavetables) {
+    switch (waveform) {
+        case 1: return SHAPE_TRIANGLE;
+        case 2: return wavetables ? SHAPE_SAW_TABLE : SHAPE_SAW_BLEP;
+        case 3: return wavetables ? SHAPE_SQUARE_TABLE : SHAPE_SQUARE_BLEP;
+        case 4: return wavetables ? SHAPE_PULSE_TABLE : SHAPE_PULSE_BLEP;
+        case 5: return SHAPE_NOISE;
+        default: return SHAPE_SINE;
+    }
+}
+
+// One oscillator sample for phase p in [0, 1)
+template <int SHAPE>
+float oscSample(float p, float dt, float pulseWidth, float noise);
+
+template <>
+inline float oscSample<SHAPE_SINE>(float p, float dt, float pulseWidth, float noise) {
+    return WaveTables::lookup(WaveTables::get().sine, p);
+}
+
+template <>
+inline float oscSample<SHAPE_TRIANGLE>(float p, float dt, float pulseWidth, float noise) {
+    return 4.f * std::abs(p - 0.5f) - 1.f;
+}
+
+template <>
+inline float oscSample<SHAPE_SAW_BLEP>(float p, float dt, float pulseWidth, float noise) {
+    return 2.f * p - 1.f - polyBlep(p, dt);
+}
+
+template <>
+inline float oscSample<SHAPE_SQUARE_BLEP>(float p, float dt, float pulseWidth, float noise) {
+    float output = p < 0.5f ? 1.f : -1.f;
+    output += polyBlep(p, dt);
+    output -= polyBlep(wrapPhase(p + 0.5f), dt);
+    return output;
+}
+
+template <>
+inline float oscSample<SHAPE_PULSE_BLEP>(float p, float dt, float pulseWidth, float noise) {
+    float output = p < pulseWidth ? 1.f : -1.f;
+    output += polyBlep(p, dt);
+    output -= polyBlep(wrapPhase(p + (1.f - pulseWidth)), dt);
+    return output;
+}
+
+template <>
+inline float oscSample<SHAPE_SAW_TABLE>(float p, float dt, float pulseWidth, float noise) {
+    return WaveTables::get().sawAt(p, dt);
+}
+
+// Pulse as the difference of two saws offset by the pulse width
+template <>
+inline float oscSample<SHAPE_PULSE_TABLE>(float p, float dt, float pulseWidth, float noise) {
+    const WaveTables& tables = WaveTables::get();
+    return tables.sawAt(wrapPhase(p + (1.f - pulseWidth)), dt) - tables.sawAt(p, dt) + 2.f * pulseWidth - 1.f;
+}
+
+template <>
+inline float oscSample<SHAPE_SQUARE_TABLE>(float p, float dt, float pulseWidth, float noise) {
+    return oscSample<SHAPE_PULSE_TABLE>(p, dt, 0.5f, noise);
+}
+
+template <>
+inline float oscSample<SHAPE_NOISE>(float p, float dt, float pulseWidth, float noise) {
+    return noise;
+}
@@ -1,16 +1,8 @@
 #include "plugin.hpp"
-
-// PolyBLEP anti-aliasing function
-inline float polyBlep(float t, float dt) {
-    if (t < dt) {
-        t /= dt;
-        return t + t - t * t - 1.f;
-    } else if (t > 1.f - dt) {
-        t = (t - 1.f) / dt;
-        return t * t + t + t + 1.f;
-    }
-    return 0.f;
-}
+#include "NoiseBank.hpp"
+#include "GenesisOsc.hpp"
+#include "Oversampler.hpp"
+#include "SampleHold.hpp"
 
 struct GenesisPoly : Module {
     enum ParamId {
@@ -45,8 +37,13 @@ struct GenesisPoly : Module {
     float phase[16] = {};
     float fmPhase[16] = {};
     dsp::SchmittTrigger syncTrigger[16];
-    float heldSample[16] = {};
-    int holdCounter[16] = {};
+    FractionalHold sampleHold[4];  // Four channels per group
+    bool bandlimitedHold = false;
+    NoiseBank<16> noise;  // One stream per channel
+    bool wavetables = false;  // Mipmapped tables instead of PolyBLEP
+    Oversampler<float> oversampler[16];  // Oscillators and bit crusher run at the high rate
+    int oversampling = 1;  // Factor the oversamplers run at
+    int requestedOversampling = 1;  // Set from the menu, applied at the top of process()
 
     GenesisPoly() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -70,99 +67,131 @@ struct GenesisPoly : Module {
 
         // Configure output
         configOutput(AUDIO_OUTPUT, "Audio");
+
+        // Build the shared wavetables here rather than on the audio thread
+        WaveTables::get();
     }
 
-    // Helper function to generate waveform from phase
-    float generateWaveform(float p, int waveform, float pulseWidth, float dt) {
-        float output = 0.f;
-        switch (waveform) {
-            case 0: // Sine
-                output = std::sin(2.f * M_PI * p);
-                break;
-            case 1: // Triangle
-                output = 4.f * std::abs(p - 0.5f) - 1.f;
-                break;
-            case 2: // Saw (with PolyBLEP)
-                output = 2.f * p - 1.f;
-                output -= polyBlep(p, dt);
-                break;
-            case 3: // Square (with PolyBLEP)
-                output = p < 0.5f ? 1.f : -1.f;
-                output += polyBlep(p, dt);
-                output -= polyBlep(fmodf(p + 0.5f, 1.f), dt);
-                break;
-            case 4: // Pulse (with PolyBLEP)
-                output = p < pulseWidth ? 1.f : -1.f;
-                output += polyBlep(p, dt);
-                output -= polyBlep(fmodf(p + (1.f - pulseWidth), 1.f), dt);
-                break;
-            case 5: // Noise (white noise)
-                output = 2.f * random::uniform() - 1.f;
-                break;
-            default:
-                output = std::sin(2.f * M_PI * p);
-                break;
-        }
-        return output;
+    json_t* dataToJson() override {
+        json_t* rootJ = json_object();
+        json_object_set_new(rootJ, "wavetables", json_boolean(wavetables));
+        json_object_set_new(rootJ, "oversampling", json_integer(requestedOversampling));
+        json_object_set_new(rootJ, "bandlimitedHold", json_boolean(bandlimitedHold));
+        return rootJ;
     }
 
-    void process(const ProcessArgs& args) override {
-        // --- Phase 2.1-2.3: Oscillator with PolyBLEP, FM & Sync - Polyphonic ---
+    void dataFromJson(json_t* rootJ) override {
+        json_t* wavetablesJ = json_object_get(rootJ, "wavetables");
+        if (wavetablesJ) wavetables = json_boolean_value(wavetablesJ);
+        json_t* oversamplingJ = json_object_get(rootJ, "oversampling");
+        if (oversamplingJ) setOversampling(json_integer_value(oversamplingJ));
+        json_t* bandlimitedHoldJ = json_object_get(rootJ, "bandlimitedHold");
+        if (bandlimitedHoldJ) bandlimitedHold = json_boolean_value(bandlimitedHoldJ);
+    }
 
-        // Get channel count from V/Oct input
-        int channels = std::max(1, inputs[VOCT_INPUT].getChannels());
+    // Only records the factor: the UI thread must not touch the oversamplers
+    // while process() is running them
+    void setOversampling(int factor) {
+        requestedOversampling = (factor >= 8) ? 8 : (factor >= 4) ? 4 : (factor >= 2) ? 2 : 1;
+    }
 
-        // Get global parameters (shared across all voices)
-        float freqParam = params[FREQ_PARAM].getValue();
-        float fineParam = params[FINE_PARAM].getValue() / 12.f; // Convert semitones
-        int waveform = static_cast<int>(params[WAVE_PARAM].getValue());
-        float pulseWidth = params[PULSE_WIDTH_PARAM].getValue();
-        float level = params[LEVEL_PARAM].getValue();
+    void applyOversampling() {
+        for (int c = 0; c < 16; c++) {
+            oversampler[c].setFactor(requestedOversampling);
+        }
+        oversampling = oversampler[0].factor;
+    }
+
+    // Values shared by every voice, evaluated once per process() call
+    struct BlockParams {
+        float freqParam;
+        float fineParam;
+        float pulseWidth;
+        float level;
+        float fmAmountParam;
+        float fmRatio;
+        float sampleTime;
+        float bitDepthParam;
+        bool polyBits;       // BITS CV differs per channel
+        float sharedLevels;  // Quantizer steps when it doesn't
+        float holdRatio;     // Target rate / engine rate
+    };
+
+    BlockParams prepareBlock(const ProcessArgs& args) {
+        BlockParams b;
+        b.freqParam = params[FREQ_PARAM].getValue();
+        b.fineParam = params[FINE_PARAM].getValue() / 12.f; // Convert semitones
+        b.pulseWidth = params[PULSE_WIDTH_PARAM].getValue();
+        b.level = params[LEVEL_PARAM].getValue();
 
         // FM parameters
-        float fmAmountParam = params[FM_AMOUNT_PARAM].getValue();
-        float fmRatio = params[FM_RATIO_PARAM].getValue();
+        b.fmAmountParam = params[FM_AMOUNT_PARAM].getValue();
+        b.fmRatio = params[FM_RATIO_PARAM].getValue();
+        b.sampleTime = args.sampleTime;
+
+        // Bit depth: one quantizer for all voices unless the CV is polyphonic
+        b.bitDepthParam = params[BIT_DEPTH_PARAM].getValue();
+        b.polyBits = inputs[BITS_INPUT].getChannels() > 1;
+        float bitDepth = b.bitDepthParam + inputs[BITS_INPUT].getVoltage() * 1.6f; // 0-10V CV maps to 0-16 bits
+        b.sharedLevels = std::pow(2.f, clamp(bitDepth, 1.f, 16.f));
+
+        // Sample rate reduction
+        float sampleRateParam = params[SAMPLE_RATE_PARAM].getValue();
+        float targetRate = 1000.f + (args.sampleRate - 1000.f) * sampleRateParam;
+        b.holdRatio = std::min(1.f, targetRate / args.sampleRate);
+        return b;
+    }
 
-        // Track max output for activity light
-        float maxOutput = 0.f;
+    // One voice for one waveform kernel; returns the signal before the
+    // sample-rate reducer
+    template <int SHAPE>
+    float processVoice(int c, const BlockParams& b) {
+        // Read pitch CV and calculate frequency for this channel
+        float pitch = b.freqParam;
+        pitch += inputs[VOCT_INPUT].getPolyVoltage(c);
+        pitch += b.fineParam;
+        float freq = dsp::FREQ_C4 * std::pow(2.f, pitch);
+
+        // Calculate phase increment for PolyBLEP
+        float dt = freq * b.sampleTime;
+
+        // FM amount with CV modulation (per-voice)
+        float fmAmount = b.fmAmountParam;
+        fmAmount += inputs[FM_INPUT].getPolyVoltage(c) * 0.2f;
+        fmAmount = clamp(fmAmount, 0.f, 1.f);
+
+        // Hard sync detection (per-voice)
+        if (syncTrigger[c].process(inputs[SYNC_INPUT].getPolyVoltage(c), 0.1f, 1.f)) {
+            phase[c] = 0.f; // Reset carrier phase on rising edge
+        }
 
-        // Process each voice
-        for (int c = 0; c < channels; c++) {
-            // Read pitch CV and calculate frequency for this channel
-            float pitch = freqParam;
-            pitch += inputs[VOCT_INPUT].getPolyVoltage(c);
-            pitch += fineParam;
-            float freq = dsp::FREQ_C4 * std::pow(2.f, pitch);
-
-            // Calculate phase increment for PolyBLEP
-            float dt = freq * args.sampleTime;
-
-            // FM amount with CV modulation (per-voice)
-            float fmAmount = fmAmountParam;
-            fmAmount += inputs[FM_INPUT].getPolyVoltage(c) * 0.2f;
-            fmAmount = clamp(fmAmount, 0.f, 1.f);
-
-            // Hard sync detection (per-voice)
-            if (syncTrigger[c].process(inputs[SYNC_INPUT].getPolyVoltage(c), 0.1f, 1.f)) {
-                phase[c] = 0.f; // Reset carrier phase on rising edge
-            }
+        // Bit depth (per-voice only with polyphonic CV)
+        float levels = b.sharedLevels;
+        if (b.polyBits) {
+            float bitDepth = b.bitDepthParam + inputs[BITS_INPUT].getPolyVoltage(c) * 1.6f;
+            levels = std::pow(2.f, clamp(bitDepth, 1.f, 16.f));
+        }
+
+        // Oscillators and bit crusher run `oversampling` times per sample
+        float subDt = dt / oversampling;
+        float fmDt = freq * b.fmRatio * b.sampleTime / oversampling;
+        float buffer[Oversampler<float>::MAX_FACTOR];
 
+        for (int i = 0; i < oversampling; i++) {
             // Carrier phase accumulation for this channel
-            phase[c] += dt;
+            phase[c] += subDt;
             if (phase[c] >= 1.f) {
                 phase[c] -= 1.f;
             }
 
             // FM modulator oscillator (ratio-based frequency)
-            float fmFreq = freq * fmRatio;
-            float fmDt = fmFreq * args.sampleTime;
             fmPhase[c] += fmDt;
             if (fmPhase[c] >= 1.f) {
                 fmPhase[c] -= 1.f;
             }
 
             // Generate modulator output (uses same waveform type)
-            float modulatorOutput = generateWaveform(fmPhase[c], waveform, pulseWidth, fmDt);
+            float modulatorOutput = oscSample<SHAPE>(fmPhase[c], fmDt, b.pulseWidth, noise.getWhite(c));
 
             // Apply phase modulation to carrier
             float modulatedPhase = phase[c] + modulatorOutput * fmAmount;
@@ -170,44 +199,70 @@ struct GenesisPoly : Module {
             modulatedPhase = fmodf(modulatedPhase + 10.f, 1.f);
 
             // Generate carrier output with modulated phase
-            float output = generateWaveform(modulatedPhase, waveform, pulseWidth, dt);
+            float output = oscSample<SHAPE>(modulatedPhase, subDt, b.pulseWidth, noise.getWhite(c));
 
             // --- Phase 2.4: Bit Crushing & Sample Rate Reduction (per-voice) ---
 
-            // Bit depth reduction
-            float bitDepth = params[BIT_DEPTH_PARAM].getValue();
-            bitDepth += inputs[BITS_INPUT].getVoltage() * 1.6f; // 0-10V CV maps to 0-16 bits
-            bitDepth = clamp(bitDepth, 1.f, 16.f);
-
             // Quantize output (normalize to 0-1, quantize, denormalize)
-            float levels = std::pow(2.f, bitDepth);
             float normalized = (output + 1.f) * 0.5f; // Map -1..1 to 0..1
             float quantized = std::floor(normalized * levels) / levels;
-            output = quantized * 2.f - 1.f; // Map 0..1 back to -1..1
+            buffer[i] = quantized * 2.f - 1.f; // Map 0..1 back to -1..1
+        }
+        return oversampler[c].downsample(buffer);
+    }
 
-            // Sample rate reduction (per-voice)
-            float sampleRateParam = params[SAMPLE_RATE_PARAM].getValue();
-            float targetRate = 1000.f + (args.sampleRate - 1000.f) * sampleRateParam;
-            int holdFrames = std::max(1, static_cast<int>(args.sampleRate / targetRate));
+    // Voice loop for one waveform kernel; returns the peak output voltage
+    template <int SHAPE>
+    float processChannels(const ProcessArgs& args, int channels) {
+        BlockParams b = prepareBlock(args);
 
-            holdCounter[c]++;
-            if (holdCounter[c] >= holdFrames) {
-                heldSample[c] = output;
-                holdCounter[c] = 0;
-            }
-            output = heldSample[c];
+        // Track max output for activity light
+        float maxOutput = 0.f;
 
-            // Apply level control
-            output *= level;
+        // Process each voice
+        alignas(16) float voiceOut[16] = {};
+        for (int c = 0; c < channels; c++) {
+            voiceOut[c] = processVoice<SHAPE>(c, b);
+        }
 
-            // Scale to VCV Rack audio range (±5V)
-            output *= 5.f;
+        // Sample rate reduction, four voices at a time
+        for (int c = 0; c < channels; c += 4) {
+            simd::float_4 output = sampleHold[c / 4].process(simd::float_4::load(&voiceOut[c]), b.holdRatio, bandlimitedHold);
+
+            // Apply level control and scale to VCV Rack audio range (±5V)
+            output *= b.level * 5.f;
+            outputs[AUDIO_OUTPUT].setVoltageSimd(output, c);
 
             // Track max for activity light
-            maxOutput = std::max(maxOutput, std::abs(output));
+            for (int i = 0; i < std::min(4, channels - c); i++) {
+                maxOutput = std::max(maxOutput, std::abs(output[i]));
+            }
+        }
+        return maxOutput;
+    }
+
+    void process(const ProcessArgs& args) override {
+        // --- Phase 2.1-2.3: Oscillator with PolyBLEP, FM & Sync - Polyphonic ---
+
+        // Get channel count from V/Oct input
+        int channels = std::max(1, inputs[VOCT_INPUT].getChannels());
+        noise.step();
+
+        if (requestedOversampling != oversampling) applyOversampling();
 
-            // Output for this channel
-            outputs[AUDIO_OUTPUT].setVoltage(output, c);
+        // Pick the waveform kernel once for all voices
+        int waveform = static_cast<int>(params[WAVE_PARAM].getValue());
+        float maxOutput = 0.f;
+        switch (oscShape(waveform, wavetables)) {
+            case SHAPE_SINE: maxOutput = processChannels<SHAPE_SINE>(args, channels); break;
+            case SHAPE_TRIANGLE: maxOutput = processChannels<SHAPE_TRIANGLE>(args, channels); break;
+            case SHAPE_SAW_BLEP: maxOutput = processChannels<SHAPE_SAW_BLEP>(args, channels); break;
+            case SHAPE_SQUARE_BLEP: maxOutput = processChannels<SHAPE_SQUARE_BLEP>(args, channels); break;
+            case SHAPE_PULSE_BLEP: maxOutput = processChannels<SHAPE_PULSE_BLEP>(args, channels); break;
+            case SHAPE_SAW_TABLE: maxOutput = processChannels<SHAPE_SAW_TABLE>(args, channels); break;
+            case SHAPE_SQUARE_TABLE: maxOutput = processChannels<SHAPE_SQUARE_TABLE>(args, channels); break;
+            case SHAPE_PULSE_TABLE: maxOutput = processChannels<SHAPE_PULSE_TABLE>(args, channels); break;
+            case SHAPE_NOISE: maxOutput = processChannels<SHAPE_NOISE>(args, channels); break;
         }
 
         // Set output channels (CRITICAL: must call after loop)
@@ -254,6 +309,24 @@ struct GenesisPolyWidget : ModuleWidget {
         // Add activity light (top center)
         addChild(createLightCentered<MediumLight<GreenLight>>(mm2px(Vec(25.4, 11.0)), module, GenesisPoly::ACTIVE_LIGHT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        GenesisPoly* module = getModule<GenesisPoly>();
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createBoolMenuItem("Band-limited wavetables", "",
+            [=]() { return module->wavetables; },
+            [=](bool enabled) { module->wavetables = enabled; }
+        ));
+        menu->addChild(createIndexSubmenuItem("Oversampling", {"Off", "2x", "4x", "8x"},
+            [=]() { int factor = module->requestedOversampling; return (size_t)(factor >= 8 ? 3 : factor / 2); },
+            [=](size_t index) { module->setOversampling(1 << index); }
+        ));
+        menu->addChild(createBoolMenuItem("Band-limited sample rate reduction", "",
+            [=]() { return module->bandlimitedHold; },
+            [=](bool enabled) { module->bandlimitedHold = enabled; }
+        ));
+    }
 };
 
 // Create model at file scope
@@ -0,0 +1,108 @@
+#pragma once
+#include <rack.hpp>
+
+using namespace rack;
+
+// Block noise source shared by all voices of a module.
+// Each stream is an independent xorshift32 generator with its own seed, so
+// voices reading different streams are decorrelated. The whole block is
+// refilled in one pass over contiguous lanes (packed integer/float ops), and
+// voices read their value by stream index instead of calling
+// random::uniform() every sample.
+template <int STREAMS>
+struct NoiseBank {
+    static const int BLOCK = 32;
+    static const int LANES = (STREAMS + 3) & ~3;  // Round up to SIMD width
+
+    // Optional variants, filled in the same pass when enabled
+    bool pinkEnabled = false;
+    bool velvetEnabled = false;
+    float velvetDensity = 0.05f;  // Impulse probability per sample
+
+    alignas(16) float white[BLOCK][LANES];
+    alignas(16) float pink[BLOCK][LANES];
+    alignas(16) float velvet[BLOCK][LANES];
+
+    alignas(16) uint32_t state[LANES];
+    alignas(16) float pinkB0[LANES] = {};
+    alignas(16) float pinkB1[LANES] = {};
+    alignas(16) float pinkB2[LANES] = {};
+    int frame = BLOCK;
+
+    NoiseBank() {
+        seed(random::u32());
+    }
+
+    void seed(uint32_t s) {
+        // Scramble (murmur3 finalizer) so neighbouring streams start far apart
+        for (int i = 0; i < LANES; i++) {
+            uint32_t z = s + 0x9E3779B9u * (uint32_t)(i + 1);
+            z = (z ^ (z >> 16)) * 0x85EBCA6Bu;
+            z = (z ^ (z >> 13)) * 0xC2B2AE35u;
+            z ^= z >> 16;
+            state[i] = z ? z : 0x6D2B79F5u;
+        }
+        frame = BLOCK;
+    }
+
+    void refill() {
+        float threshold = 1.0f - velvetDensity;
+        for (int f = 0; f < BLOCK; f++) {
+            // Branch-free lane loop, vectorized by the compiler
+            for (int i = 0; i < LANES; i++) {
+                uint32_t x = state[i];
+                x ^= x << 13;
+                x ^= x >> 17;
+                x ^= x << 5;
+                state[i] = x;
+                // Top 23 bits as mantissa: [1, 2) -> [-1, 1)
+                uint32_t bits = (x >> 9) | 0x3F800000u;
+                float u;
+                std::memcpy(&u, &bits, sizeof(u));
+                white[f][i] = u * 2.0f - 3.0f;
+            }
+        }
+
+        if (pinkEnabled) {
+            // Paul Kellet's economy pink filter (-3dB/oct within 1/4 dB)
+            for (int f = 0; f < BLOCK; f++) {
+                for (int i = 0; i < LANES; i++) {
+                    float w = white[f][i];
+                    pinkB0[i] = 0.99765f * pinkB0[i] + w * 0.0990460f;
+                    pinkB1[i] = 0.96300f * pinkB1[i] + w * 0.2965164f;
+                    pinkB2[i] = 0.57000f * pinkB2[i] + w * 1.0526913f;
+                    pink[f][i] = (pinkB0[i] + pinkB1[i] + pinkB2[i] + w * 0.1848f) * 0.25f;
+                }
+            }
+        }
+
+        if (velvetEnabled) {
+            // Sparse +/-1 impulses, sign taken from the same uniform draw
+            for (int f = 0; f < BLOCK; f++) {
+                for (int i = 0; i < LANES; i++) {
+                    float w = white[f][i];
+                    velvet[f][i] = (w > threshold) ? 1.0f : ((w < -threshold) ? -1.0f : 0.0f);
+                }
+            }
+        }
+
+        frame = 0;
+    }
+
+    // Advance one frame. Call once per process() before reading streams.
+    void step() {
+        if (++frame >= BLOCK) refill();
+    }
+
+    float getWhite(int stream) const {
+        return white[frame][stream];
+    }
+
+    float getPink(int stream) const {
+        return pink[frame][stream];
+    }
+
+    float getVelvet(int stream) const {
+        return velvet[frame][stream];
+    }
+};
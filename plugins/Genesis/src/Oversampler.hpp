@@ -0,0 +1,191 @@
+#pragma once
+#include <rack.hpp>
+
+using namespace rack;
+
+// 2x/4x/8x oversampling built from cascaded polyphase halfband FIR stages.
+// T is float for one channel or simd::float_4 for four channels at once.
+// Usage per base-rate sample:
+//     T buf[Oversampler<T>::MAX_FACTOR];
+//     os.upsample(x, buf);  // or generate buf[] directly at the high rate
+//     for (int i = 0; i < os.factor; i++) buf[i] = shape(buf[i]);
+//     T y = os.downsample(buf);
+
+// Nonzero side taps of a Kaiser-windowed halfband lowpass with 4K - 1 taps.
+// The centre tap is 0.5 and every other tap is zero, so each polyphase
+// branch is either these 2K taps or a plain delay.
+template <int K>
+struct HalfbandTaps {
+    float g[2 * K];
+
+    HalfbandTaps() {
+        const double beta = 8.0;
+        const double centre = 2 * K - 1;
+        double sum = 0.0;
+        for (int j = 0; j < 2 * K; j++) {
+            double d = 2 * j - centre;  // Odd offset from the centre tap
+            double ideal = std::sin(M_PI * d / 2.0) / (M_PI * d);
+            double r = d / (centre + 1.0);
+            g[j] = (float)(ideal * besselI0(beta * std::sqrt(1.0 - r * r)) / besselI0(beta));
+            sum += g[j];
+        }
+        // Side taps sum to 0.5 for unity DC gain
+        for (int j = 0; j < 2 * K; j++) {
+            g[j] = (float)(g[j] * 0.5 / sum);
+        }
+    }
+
+    static double besselI0(double x) {
+        double term = 1.0, sum = 1.0;
+        for (int k = 1; k < 32; k++) {
+            term *= (x / (2.0 * k)) * (x / (2.0 * k));
+            sum += term;
+        }
+        return sum;
+    }
+
+    static const HalfbandTaps& get() {
+        static HalfbandTaps taps;
+        return taps;
+    }
+};
+
+// Doubles the rate: one input sample in, two out
+template <typename T, int K>
+struct HalfbandUpsampler {
+    T hist[4 * K];  // Doubled ring so the taps read contiguously
+    int pos = 0;
+
+    HalfbandUpsampler() {
+        reset();
+    }
+
+    void reset() {
+        for (int i = 0; i < 4 * K; i++) hist[i] = T(0.f);
+        pos = 0;
+    }
+
+    void process(T x, T& y0, T& y1) {
+        const float* g = HalfbandTaps<K>::get().g;
+        pos = (pos == 0) ? 2 * K - 1 : pos - 1;
+        hist[pos] = x;
+        hist[pos + 2 * K] = x;
+
+        T acc = 0.f;
+        for (int j = 0; j < 2 * K; j++) {
+            acc += hist[pos + j] * g[j];
+        }
+        y0 = acc * 2.f;
+        y1 = hist[pos + K - 1];
+    }
+};
+
+// Halves the rate: two input samples in, one out
+template <typename T, int K>
+struct HalfbandDecimator {
+    T odd[4 * K];
+    T even[4 * K];
+    int pos = 0;
+
+    HalfbandDecimator() {
+        reset();
+    }
+
+    void reset() {
+        for (int i = 0; i < 4 * K; i++) {
+            odd[i] = T(0.f);
+            even[i] = T(0.f);
+        }
+        pos = 0;
+    }
+
+    T process(T x0, T x1) {
+        const float* g = HalfbandTaps<K>::get().g;
+        pos = (pos == 0) ? 2 * K - 1 : pos - 1;
+        even[pos] = x0;
+        even[pos + 2 * K] = x0;
+        odd[pos] = x1;
+        odd[pos + 2 * K] = x1;
+
+        T acc = even[pos + K - 1] * 0.5f;
+        for (int j = 0; j < 2 * K; j++) {
+            acc += odd[pos + j] * g[j];
+        }
+        return acc;
+    }
+};
+
+template <typename T>
+struct Oversampler {
+    static const int MAX_FACTOR = 8;
+
+    // The stage next to the base rate does the real anti-aliasing work and
+    // gets the long filter; the inner stages only guard wide transition bands.
+    HalfbandUpsampler<T, 16> up1;
+    HalfbandUpsampler<T, 6> up2;
+    HalfbandUpsampler<T, 4> up3;
+    HalfbandDecimator<T, 16> down1;
+    HalfbandDecimator<T, 6> down2;
+    HalfbandDecimator<T, 4> down3;
+
+    int factor = 1;  // 1, 2, 4 or 8
+
+    void setFactor(int f) {
+        f = (f >= 8) ? 8 : (f >= 4) ? 4 : (f >= 2) ? 2 : 1;
+        if (f != factor) {
+            factor = f;
+            reset();
+        }
+    }
+
+    void reset() {
+        up1.reset();
+        up2.reset();
+        up3.reset();
+        down1.reset();
+        down2.reset();
+        down3.reset();
+    }
+
+    // Fill out[0 .. factor-1] from one base-rate sample
+    void upsample(T in, T* out) {
+        if (factor == 1) {
+            out[0] = in;
+            return;
+        }
+        up1.process(in, out[0], out[1]);
+        if (factor == 2) return;
+
+        T a[2] = {out[0], out[1]};
+        for (int i = 0; i < 2; i++) {
+            up2.process(a[i], out[2 * i], out[2 * i + 1]);
+        }
+        if (factor == 4) return;
+
+        T b[4] = {out[0], out[1], out[2], out[3]};
+        for (int i = 0; i < 4; i++) {
+            up3.process(b[i], out[2 * i], out[2 * i + 1]);
+        }
+    }
+
+    // Reduce in[0 .. factor-1] to one base-rate sample
+    T downsample(const T* in) {
+        if (factor == 1) return in[0];
+
+        T b[4];
+        if (factor == 8) {
+            for (int i = 0; i < 4; i++) {
+                b[i] = down3.process(in[2 * i], in[2 * i + 1]);
+            }
+            in = b;
+        }
+        T a[2];
+        if (factor >= 4) {
+            for (int i = 0; i < 2; i++) {
+                a[i] = down2.process(in[2 * i], in[2 * i + 1]);
+            }
+            in = a;
+        }
+        return down1.process(in[0], in[1]);
+    }
+};
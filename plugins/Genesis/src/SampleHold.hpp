@@ -0,0 +1,60 @@
+#pragma once
+#include <rack.hpp>
+
+using namespace rack;
+
+// Sample-rate reducer with fractional hold periods, four channels per call.
+// A phase accumulator advances by targetRate / sampleRate each frame. When it
+// wraps, the input is sampled at the exact sub-sample instant of the wrap
+// (linear interpolation between frames), so the effective rate moves smoothly
+// instead of in integer hold lengths. Optionally the step to the new value is
+// band-limited with a minBLEP.
+struct FractionalHold {
+    simd::float_4 phase = 0.f;
+    simd::float_4 held = 0.f;
+    simd::float_4 prevInput = 0.f;
+    dsp::MinBlepGenerator<16, 16, simd::float_4> blep;
+
+    void reset() {
+        phase = 0.f;
+        held = 0.f;
+        prevInput = 0.f;
+    }
+
+    // ratio = targetRate / sampleRate, at most 1
+    simd::float_4 process(simd::float_4 in, simd::float_4 ratio, bool bandlimited) {
+        using simd::float_4;
+
+        // At full rate the stage is a plain pass-through. Dropping the phase
+        // remainder here keeps a wrap offset left over from a lower rate from
+        // turning it into a fractional-delay interpolator.
+        float_4 fullRate = ratio >= 1.f;
+        phase = simd::ifelse(fullRate, 0.f, phase + ratio);
+        held = simd::ifelse(fullRate, in, held);
+
+        float_4 wrapped = phase >= 1.f;
+        int mask = simd::movemask(wrapped);
+        if (mask) {
+            phase -= simd::ifelse(wrapped, 1.f, 0.f);
+
+            // Wrap instant in (-1, 0] frames relative to this one
+            float_4 p = -phase / ratio;
+            float_4 sample = in + (in - prevInput) * p;
+            float_4 step = simd::ifelse(wrapped, sample - held, 0.f);
+            held += step;
+
+            if (bandlimited) {
+                for (int i = 0; i < 4; i++) {
+                    if (!(mask & (1 << i))) continue;
+                    float_4 x = 0.f;
+                    x[i] = step[i];
+                    blep.insertDiscontinuity(p[i], x);
+                }
+            }
+        }
+        prevInput = in;
+
+        // The minBLEP tail keeps draining after the option is switched off
+        return held + blep.process();
+    }
+};
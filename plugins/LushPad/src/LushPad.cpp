@@ -1,4 +1,5 @@
 #include "plugin.hpp"
+#include "Denormals.hpp"
 
 // Simple ADSR envelope
 struct ADSREnvelope {
@@ -6,15 +7,25 @@ struct ADSREnvelope {
     Stage stage = IDLE;
     float value = 0.0f;
     float attack = 0.3f, decay = 0.2f, sustain = 0.8f, release = 2.0f;
+    float fadeTime = 0.005f;  // Release used when the voice is stolen
+    bool fading = false;
 
     void noteOn() {
         stage = ATTACK;
+        fading = false;
     }
 
     void noteOff() {
         if (stage != IDLE) stage = RELEASE;
     }
 
+    void fadeOut() {
+        if (stage != IDLE) {
+            stage = RELEASE;
+            fading = true;
+        }
+    }
+
     bool isActive() const {
         return stage != IDLE;
     }
@@ -42,7 +53,7 @@ struct ADSREnvelope {
                 value = sustain;
                 break;
             case RELEASE:
-                rate = 1.0f / (release * sampleRate);
+                rate = 1.0f / ((fading ? fadeTime : release) * sampleRate);
                 value -= rate;
                 if (value <= 0.0f) {
                     value = 0.0f;
@@ -62,144 +73,296 @@ struct ADSREnvelope {
     }
 };
 
-// Simple one-pole lowpass filter
-struct OnePoleLP {
-    float y1 = 0.0f;
-
-    float process(float x, float cutoff, float sampleRate) {
-        float w = 2.0f * M_PI * cutoff / sampleRate;
-        float coef = 1.0f - std::exp(-w);
-        y1 += coef * (x - y1);
-        return y1;
-    }
-
-    void reset() { y1 = 0.0f; }
-};
-
-// Simple allpass for reverb
-struct AllpassDelay {
-    static const int MAX_SIZE = 8192;
-    float buffer[MAX_SIZE] = {0.0f};
+// Normalized 8x8 Hadamard transform of two float_4 halves, as butterflies
+inline void hadamard8(simd::float_4& a, simd::float_4& b) {
+    using simd::float_4;
+    const float_4 pairSign(1.0f, -1.0f, 1.0f, -1.0f);
+    const float_4 halfSign(1.0f, 1.0f, -1.0f, -1.0f);
+
+    // Adjacent pairs, then pairs two apart, within each half
+    a = float_4(_mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(2, 3, 0, 1))) + a * pairSign;
+    b = float_4(_mm_shuffle_ps(b.v, b.v, _MM_SHUFFLE(2, 3, 0, 1))) + b * pairSign;
+    a = float_4(_mm_shuffle_ps(a.v, a.v, _MM_SHUFFLE(1, 0, 3, 2))) + a * halfSign;
+    b = float_4(_mm_shuffle_ps(b.v, b.v, _MM_SHUFFLE(1, 0, 3, 2))) + b * halfSign;
+
+    // Across halves, scaled by 1/sqrt(8) to stay lossless
+    float_4 sum = (a + b) * 0.35355339f;
+    b = (a - b) * 0.35355339f;
+    a = sum;
+}
+
+// 8-line feedback delay network reverb.
+// Delay lines are power-of-two buffers indexed with a mask; size and decay are
+// applied by setParams() at block rate, not per sample.
+struct FDNReverb {
+    static const int LINES = 8;
+    static const int BUFFER_SIZE = 32768;  // Holds size 2x at 192 kHz
+    static const int MASK = BUFFER_SIZE - 1;
+
+    // Mutually prime line lengths at 44.1 kHz, size 1x
+    const float baseLength[LINES] = {1031, 1327, 1523, 1871, 2053, 2437, 2719, 3109};
+
+    float buffer[LINES][BUFFER_SIZE] = {};
     int writePos = 0;
-    int delaySamples = 1000;
-    float feedback = 0.5f;
+    int delay[LINES] = {};
+    int targetDelay[LINES] = {};
+    bool primed = false;
+
+    alignas(16) float gain[LINES] = {};
+    simd::float_4 dampA = 0.0f, dampB = 0.0f;
+    float dampCoef = 1.0f;
+
+    void setParams(float size, float decay, float sampleRate) {
+        float scale = size * sampleRate / 44100.0f;
+        for (int i = 0; i < LINES; i++) {
+            targetDelay[i] = clamp((int)(baseLength[i] * scale), 1, MASK);
+            // Glide one sample per block so size changes don't click
+            if (!primed) {
+                delay[i] = targetDelay[i];
+            } else if (delay[i] != targetDelay[i]) {
+                delay[i] += (targetDelay[i] > delay[i]) ? 1 : -1;
+            }
+            // -60 dB after `decay` seconds
+            gain[i] = std::pow(10.0f, -3.0f * delay[i] / (decay * sampleRate));
+        }
+        primed = true;
 
-    void setParams(int delay, float fb) {
-        delaySamples = clamp(delay, 1, MAX_SIZE - 1);
-        feedback = fb;
+        // Gentle high damping in the loop
+        dampCoef = 1.0f - std::exp(-2.0f * M_PI * 6000.0f / sampleRate);
     }
 
-    float process(float input) {
-        int readPos = writePos - delaySamples;
-        if (readPos < 0) readPos += MAX_SIZE;
-
-        float delayed = buffer[readPos];
-        float output = -input + delayed;
-        buffer[writePos] = input + delayed * feedback;
+    void process(float inL, float inR, float& outL, float& outR) {
+        using simd::float_4;
+        alignas(16) float tap[LINES];
+        for (int i = 0; i < LINES; i++) {
+            tap[i] = buffer[i][(writePos - delay[i]) & MASK];
+        }
 
-        writePos = (writePos + 1) % MAX_SIZE;
-        return output;
+        float_4 a = float_4::load(&tap[0]);
+        float_4 b = float_4::load(&tap[4]);
+        dampA += dampCoef * (a - dampA) + ANTI_DENORMAL;
+        dampB += dampCoef * (b - dampB) + ANTI_DENORMAL;
+        a = dampA * float_4::load(&gain[0]);
+        b = dampB * float_4::load(&gain[4]);
+
+        // Left from the first four lines, right from the last four
+        outL = (a[0] - a[1] + a[2] - a[3]) * 0.5f;
+        outR = (b[0] - b[1] + b[2] - b[3]) * 0.5f;
+
+        hadamard8(a, b);
+        a += inL * 0.5f;
+        b += inR * 0.5f;
+        a.store(&tap[0]);
+        b.store(&tap[4]);
+
+        for (int i = 0; i < LINES; i++) {
+            buffer[i][writePos] = tap[i];
+        }
+        writePos = (writePos + 1) & MASK;
     }
 
     void clear() {
         memset(buffer, 0, sizeof(buffer));
+        dampA = 0.0f;
+        dampB = 0.0f;
     }
 };
 
-// Synth voice
-struct PadVoice {
-    bool active = false;
-    float phase1 = 0.0f, phase2 = 0.0f, phase3 = 0.0f;
-    float prevOut1 = 0.0f, prevOut2 = 0.0f, prevOut3 = 0.0f;
-    float frequency = 440.0f;
-    float velocity = 1.0f;
-    ADSREnvelope env;
-    OnePoleLP filter;
-
-    // LFO for modulation
-    float lfoPhase = 0.0f;
-    float lfoFreq = 0.1f;
-
-    void trigger(float freq, float vel) {
-        active = true;
-        frequency = freq;
-        velocity = vel;
-        phase1 = phase2 = phase3 = 0.0f;
-        prevOut1 = prevOut2 = prevOut3 = 0.0f;
-        lfoPhase = random::uniform() * 2.0f * M_PI;
-        lfoFreq = 0.05f + random::uniform() * 0.15f;
-        env.noteOn();
+// Pade approximant of tanh, reaches 1 at +/-3 and is clamped beyond
+inline simd::float_4 tanhPade(simd::float_4 x) {
+    x = simd::fmin(simd::fmax(x, -3.0f), 3.0f);
+    simd::float_4 x2 = x * x;
+    return x * (27.0f + x2) / (27.0f + 9.0f * x2);
+}
+
+// All pad voices in structure-of-arrays form. Four voices share a float_4
+// lane group, and each group runs its three detuned FM operators side by side.
+struct PadVoiceBank {
+    static const int VOICES = 16;
+    static const int GROUPS = VOICES / 4;
+
+    // Detuning ratios (±7 cents)
+    const float ratios[3] = {1.0f, 1.00407f, 0.99593f};
+
+    // Operators
+    alignas(16) float phase[3][VOICES] = {};
+    alignas(16) float phaseInc[3][VOICES] = {};
+    alignas(16) float prevOut[3][VOICES] = {};
+
+    // Per-voice pitch, velocity, LFO and filter
+    alignas(16) float frequency[VOICES] = {};
+    alignas(16) float velocity[VOICES] = {};
+    alignas(16) float lfoPhase[VOICES] = {};
+    alignas(16) float lfoFreq[VOICES] = {};
+    alignas(16) float lfoInc[VOICES] = {};
+    alignas(16) float filterY1[VOICES] = {};
+    alignas(16) float filterCoef[VOICES] = {};
+    alignas(16) float envValue[VOICES] = {};
+    ADSREnvelope env[VOICES];
+
+    // Notes waiting for a stolen voice to finish its fade
+    float pendingFreq[VOICES] = {};
+    float pendingVel[VOICES] = {};
+
+    // Bit v set while voice v is sounding / has a pending note
+    uint32_t activeMask = 0;
+    uint32_t pendingMask = 0;
+
+    // Control-rate inputs, kept for voices triggered between updates
+    float filterCutoff = 2000.0f;
+    float sampleRate = 44100.0f;
+
+    bool isActive(int v) const {
+        return activeMask & (1u << v);
     }
 
-    void release() {
-        env.noteOff();
+    void trigger(int v, float freq, float vel) {
+        activeMask |= 1u << v;
+        frequency[v] = freq;
+        velocity[v] = vel;
+        for (int k = 0; k < 3; k++) {
+            phase[k][v] = 0.0f;
+            prevOut[k][v] = 0.0f;
+        }
+        filterY1[v] = 0.0f;
+        lfoPhase[v] = random::uniform() * 2.0f * M_PI;
+        lfoFreq[v] = 0.05f + random::uniform() * 0.15f;
+        updateVoice(v);
+        env[v].noteOn();
     }
 
-    void process(float& outL, float& outR, float timbre, float filterCutoff, float sampleRate) {
-        if (!active) {
-            outL = outR = 0.0f;
+    // Fade the sounding voice out quickly, then start the new note on it
+    void steal(int v, float freq, float vel) {
+        pendingFreq[v] = freq;
+        pendingVel[v] = vel;
+        pendingMask |= 1u << v;
+        env[v].fadeOut();
+    }
+
+    void release(int v) {
+        if (pendingMask & (1u << v)) {
+            // Released before it started: drop it and let the fade finish
+            pendingMask &= ~(1u << v);
             return;
         }
+        env[v].noteOff();
+    }
+
+    float level(int v) const {
+        return env[v].value;
+    }
+
+    void reset() {
+        for (int v = 0; v < VOICES; v++) {
+            env[v].reset();
+            filterY1[v] = 0.0f;
+        }
+        activeMask = 0;
+        pendingMask = 0;
+    }
+
+    void updateVoice(int v) {
+        float w = 2.0f * M_PI / sampleRate;
+        for (int k = 0; k < 3; k++) {
+            phaseInc[k][v] = frequency[v] * ratios[k] * w;
+        }
+        lfoInc[v] = lfoFreq[v] * w;
+        // Filter with velocity-scaled cutoff
+        float velCutoff = filterCutoff * (0.5f + 0.5f * velocity[v]);
+        filterCoef[v] = 1.0f - std::exp(-velCutoff * w);
+    }
+
+    // Recompute increments and filter coefficients for all voices
+    void updateControl(float cutoff, float rate) {
+        using simd::float_4;
+        filterCutoff = cutoff;
+        sampleRate = rate;
+        float_4 w = 2.0f * M_PI / rate;
+
+        for (int g = 0; g < GROUPS; g++) {
+            int o = 4 * g;
+            float_4 freq = float_4::load(&frequency[o]);
+            for (int k = 0; k < 3; k++) {
+                (freq * ratios[k] * w).store(&phaseInc[k][o]);
+            }
+            (float_4::load(&lfoFreq[o]) * w).store(&lfoInc[o]);
+            float_4 velCutoff = cutoff * (0.5f + 0.5f * float_4::load(&velocity[o]));
+            (1.0f - simd::exp(-velCutoff * w)).store(&filterCoef[o]);
+        }
+    }
 
-        // Update LFO
-        lfoPhase += (lfoFreq * 2.0f * M_PI) / sampleRate;
-        if (lfoPhase >= 2.0f * M_PI) lfoPhase -= 2.0f * M_PI;
-        float lfoVal = std::sin(lfoPhase);
+    void process(float& outL, float& outR, float timbre) {
+        using simd::float_4;
+        const float twoPi = 2.0f * M_PI;
 
-        // FM feedback depth modulated by timbre and LFO
-        float fbDepth = timbre * 0.4f * (1.0f + lfoVal * 0.2f);
+        // Envelopes stay scalar state machines, one per sounding voice
+        uint32_t finished = 0;
+        for (int v = 0; v < VOICES; v++) {
+            if (!isActive(v)) continue;
+            envValue[v] = env[v].process(sampleRate);
+            if (!env[v].isActive()) finished |= 1u << v;
+        }
 
-        // Detuning ratios (±7 cents)
-        float ratio1 = 1.0f;
-        float ratio2 = 1.00407f;  // +7 cents
-        float ratio3 = 0.99593f;  // -7 cents
+        float_4 sumL = 0.0f, sumR = 0.0f;
+        float_4 satGain = 1.0f + timbre * 2.0f;
+
+        for (int g = 0; g < GROUPS; g++) {
+            if (!((activeMask >> (4 * g)) & 0xF)) continue;
+            int o = 4 * g;
+
+            // Update LFO
+            float_4 lfo = float_4::load(&lfoPhase[o]) + float_4::load(&lfoInc[o]);
+            lfo -= simd::ifelse(lfo >= twoPi, twoPi, 0.0f);
+            lfo.store(&lfoPhase[o]);
+            float_4 lfoVal = simd::sin(lfo);
+
+            // FM feedback depth modulated by timbre and LFO
+            float_4 fbDepth = timbre * 0.4f * (1.0f + lfoVal * 0.2f);
+
+            // 3 detuned FM operators per voice
+            float_4 mix = 0.0f;
+            for (int k = 0; k < 3; k++) {
+                float_4 ph = float_4::load(&phase[k][o]);
+                float_4 osc = simd::sin(ph + fbDepth * float_4::load(&prevOut[k][o]));
+                osc.store(&prevOut[k][o]);
+                mix += osc;
+
+                ph += float_4::load(&phaseInc[k][o]);
+                ph -= simd::ifelse(ph >= twoPi, twoPi, 0.0f);
+                ph.store(&phase[k][o]);
+            }
+            mix *= 1.0f / 3.0f;
 
-        // Generate 3 detuned FM oscillators
-        float osc1 = std::sin(phase1 + fbDepth * prevOut1);
-        float osc2 = std::sin(phase2 + fbDepth * prevOut2);
-        float osc3 = std::sin(phase3 + fbDepth * prevOut3);
+            // Saturation modulated by timbre
+            mix = tanhPade(mix * satGain);
 
-        prevOut1 = osc1;
-        prevOut2 = osc2;
-        prevOut3 = osc3;
+            // One-pole lowpass
+            float_4 y1 = float_4::load(&filterY1[o]);
+            y1 += float_4::load(&filterCoef[o]) * (mix - y1);
+            y1.store(&filterY1[o]);
 
-        // Mix oscillators
-        float mix = (osc1 + osc2 + osc3) / 3.0f;
+            // Envelope (idle lanes hold 0)
+            mix = y1 * float_4::load(&envValue[o]) * float_4::load(&velocity[o]);
 
-        // Saturation modulated by timbre
-        float satGain = 1.0f + timbre * 2.0f;
-        mix = std::tanh(mix * satGain);
+            // Pan based on LFO
+            float_4 pan = 0.5f + lfoVal * 0.3f;
+            sumL += mix * (1.0f - pan);
+            sumR += mix * pan;
+        }
 
-        // Filter with velocity-scaled cutoff
-        float velCutoff = filterCutoff * (0.5f + 0.5f * velocity);
-        mix = filter.process(mix, velCutoff, sampleRate);
-
-        // Envelope
-        float envVal = env.process(sampleRate);
-        mix *= envVal * velocity;
-
-        // Pan based on LFO
-        float pan = 0.5f + lfoVal * 0.3f;
-        outL = mix * (1.0f - pan);
-        outR = mix * pan;
-
-        // Advance phases
-        float inc1 = (frequency * ratio1 * 2.0f * M_PI) / sampleRate;
-        float inc2 = (frequency * ratio2 * 2.0f * M_PI) / sampleRate;
-        float inc3 = (frequency * ratio3 * 2.0f * M_PI) / sampleRate;
-
-        phase1 += inc1;
-        phase2 += inc2;
-        phase3 += inc3;
-
-        if (phase1 >= 2.0f * M_PI) phase1 -= 2.0f * M_PI;
-        if (phase2 >= 2.0f * M_PI) phase2 -= 2.0f * M_PI;
-        if (phase3 >= 2.0f * M_PI) phase3 -= 2.0f * M_PI;
-
-        // Check if voice finished
-        if (!env.isActive()) {
-            active = false;
+        for (int v = 0; v < VOICES; v++) {
+            if (!(finished & (1u << v))) continue;
+            envValue[v] = 0.0f;
+            if (pendingMask & (1u << v)) {
+                pendingMask &= ~(1u << v);
+                finished &= ~(1u << v);
+                trigger(v, pendingFreq[v], pendingVel[v]);
+            }
         }
+        activeMask &= ~finished;
+
+        outL = sumL[0] + sumL[1] + sumL[2] + sumL[3];
+        outR = sumR[0] + sumR[1] + sumR[2] + sumR[3];
     }
 };
 
@@ -208,6 +371,8 @@ struct LushPad : Module {
         TIMBRE_PARAM,
         FILTER_PARAM,
         REVERB_PARAM,
+        SIZE_PARAM,
+        DECAY_PARAM,
         PARAMS_LEN
     };
     enum InputId {
@@ -226,16 +391,25 @@ struct LushPad : Module {
         LIGHTS_LEN
     };
 
-    static const int NUM_VOICES = 8;
-    PadVoice voices[NUM_VOICES];
-    int nextVoice = 0;
+    // One voice per poly channel
+    static const int NUM_VOICES = PadVoiceBank::VOICES;
+    PadVoiceBank voices;
+
+    // Voice allocation: gate channel -> voice and back, -1 when unmapped
+    int channelVoice[16];
+    int voiceChannel[NUM_VOICES];
+    uint32_t voiceAge[NUM_VOICES] = {};
+    uint32_t noteCounter = 0;
+
+    // Filter coefficients and increments are refreshed every CONTROL_INTERVAL samples
+    static const int CONTROL_INTERVAL = 16;
+    int controlCounter = 0;
 
     // Gate tracking for polyphonic input
     dsp::SchmittTrigger gateTrigger[16];
     bool gateHigh[16] = {false};
 
-    // Simple reverb (4 allpass delays)
-    AllpassDelay allpass1L, allpass2L, allpass1R, allpass2R;
+    FDNReverb reverb;
 
     LushPad() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
@@ -243,6 +417,8 @@ struct LushPad : Module {
         configParam(TIMBRE_PARAM, 0.0f, 1.0f, 0.35f, "Timbre", "%", 0.0f, 100.0f);
         configParam(FILTER_PARAM, 20.0f, 20000.0f, 2000.0f, "Filter Cutoff", " Hz");
         configParam(REVERB_PARAM, 0.0f, 1.0f, 0.4f, "Reverb", "%", 0.0f, 100.0f);
+        configParam(SIZE_PARAM, 0.5f, 2.0f, 1.0f, "Reverb Size", "x");
+        configParam(DECAY_PARAM, 0.5f, 20.0f, 4.0f, "Reverb Decay", " s");
 
         configInput(VOCT_INPUT, "V/Oct");
         configInput(GATE_INPUT, "Gate");
@@ -252,43 +428,85 @@ struct LushPad : Module {
         configOutput(LEFT_OUTPUT, "Left");
         configOutput(RIGHT_OUTPUT, "Right");
 
-        // Initialize reverb delays
-        allpass1L.setParams(1051, 0.7f);
-        allpass2L.setParams(337, 0.7f);
-        allpass1R.setParams(1117, 0.7f);
-        allpass2R.setParams(379, 0.7f);
+        clearVoiceMap();
+    }
+
+    void clearVoiceMap() {
+        for (int c = 0; c < 16; c++) {
+            channelVoice[c] = -1;
+            gateHigh[c] = false;
+        }
+        for (int v = 0; v < NUM_VOICES; v++) {
+            voiceChannel[v] = -1;
+        }
     }
 
     void onReset() override {
-        for (auto& voice : voices) {
-            voice.active = false;
-            voice.env.reset();
-            voice.filter.reset();
+        voices.reset();
+        clearVoiceMap();
+        reverb.clear();
+    }
+
+    int allocateVoice() {
+        // First try to find an idle voice
+        for (int v = 0; v < NUM_VOICES; v++) {
+            if (!voices.isActive(v)) return v;
+        }
+        // Then the quietest voice already in its release
+        int best = -1;
+        float quietest = INFINITY;
+        for (int v = 0; v < NUM_VOICES; v++) {
+            if (voiceChannel[v] < 0 && voices.level(v) < quietest) {
+                quietest = voices.level(v);
+                best = v;
+            }
         }
-        allpass1L.clear();
-        allpass2L.clear();
-        allpass1R.clear();
-        allpass2R.clear();
+        if (best >= 0) return best;
+        // Finally steal the oldest held note
+        uint32_t oldest = 0;
+        for (int v = 0; v < NUM_VOICES; v++) {
+            uint32_t age = noteCounter - voiceAge[v];
+            if (age >= oldest) {
+                oldest = age;
+                best = v;
+            }
+        }
+        return best;
     }
 
-    int findFreeVoice() {
-        // First try to find inactive voice
-        for (int i = 0; i < NUM_VOICES; i++) {
-            if (!voices[i].active) return i;
+    void noteOn(int c, float freq) {
+        int v = allocateVoice();
+        if (voiceChannel[v] >= 0) channelVoice[voiceChannel[v]] = -1;
+
+        if (voices.isActive(v)) {
+            voices.steal(v, freq, 0.8f);
+        } else {
+            voices.trigger(v, freq, 0.8f);
         }
-        // Steal oldest (round-robin)
-        int idx = nextVoice;
-        nextVoice = (nextVoice + 1) % NUM_VOICES;
-        return idx;
+        channelVoice[c] = v;
+        voiceChannel[v] = c;
+        voiceAge[v] = noteCounter++;
+    }
+
+    void noteOff(int c) {
+        int v = channelVoice[c];
+        if (v < 0) return;
+        voices.release(v);
+        voiceChannel[v] = -1;
+        channelVoice[c] = -1;
     }
 
     void process(const ProcessArgs& args) override {
+        DenormalGuard denormalGuard;
+
         float sampleRate = args.sampleRate;
 
         // Get parameters
         float timbre = params[TIMBRE_PARAM].getValue();
         float filterCutoff = params[FILTER_PARAM].getValue();
         float reverbMix = params[REVERB_PARAM].getValue();
+        float reverbSize = params[SIZE_PARAM].getValue();
+        float reverbDecay = params[DECAY_PARAM].getValue();
 
         // CV modulation
         if (inputs[TIMBRE_CV_INPUT].isConnected()) {
@@ -302,50 +520,41 @@ struct LushPad : Module {
         }
 
         // Process polyphonic gates
+        // Channels beyond the cable's count read as low so their notes release
         int numChannels = std::max(1, inputs[GATE_INPUT].getChannels());
-        for (int c = 0; c < numChannels; c++) {
-            float gate = inputs[GATE_INPUT].getVoltage(c);
-            bool high = gate >= 1.0f;
+        for (int c = 0; c < 16; c++) {
+            bool high = c < numChannels && inputs[GATE_INPUT].getVoltage(c) >= 1.0f;
+            if (high == gateHigh[c]) continue;
 
-            if (high && !gateHigh[c]) {
+            if (high) {
                 // Note on
                 float voct = inputs[VOCT_INPUT].getVoltage(c);
-                float freq = 261.626f * std::pow(2.0f, voct);  // C4 base
-                int v = findFreeVoice();
-                voices[v].trigger(freq, 0.8f);
-            } else if (!high && gateHigh[c]) {
-                // Note off - find voice playing this frequency
-                float voct = inputs[VOCT_INPUT].getVoltage(c);
-                float freq = 261.626f * std::pow(2.0f, voct);
-                for (auto& voice : voices) {
-                    if (voice.active && std::abs(voice.frequency - freq) < 1.0f) {
-                        voice.release();
-                        break;
-                    }
-                }
+                noteOn(c, dsp::FREQ_C4 * dsp::exp2_taylor5(voct));
+            } else {
+                // Note off - the channel's own voice, no pitch lookup
+                noteOff(c);
             }
             gateHigh[c] = high;
         }
 
-        // Process all voices
-        float mixL = 0.0f, mixR = 0.0f;
-        for (auto& voice : voices) {
-            float vL, vR;
-            voice.process(vL, vR, timbre, filterCutoff, sampleRate);
-            mixL += vL;
-            mixR += vR;
+        if (controlCounter-- <= 0) {
+            controlCounter = CONTROL_INTERVAL - 1;
+            voices.updateControl(filterCutoff, sampleRate);
+            reverb.setParams(reverbSize, reverbDecay, sampleRate);
         }
 
+        // Process all voices
+        float mixL, mixR;
+        voices.process(mixL, mixR, timbre);
+
         // Scale down
         mixL *= 0.25f;
         mixR *= 0.25f;
 
-        // Simple reverb
+        // Reverb
         float dryL = mixL, dryR = mixR;
-        float wetL = allpass1L.process(mixL);
-        wetL = allpass2L.process(wetL);
-        float wetR = allpass1R.process(mixR);
-        wetR = allpass2R.process(wetR);
+        float wetL, wetR;
+        reverb.process(mixL, mixR, wetL, wetR);
 
         // Mix dry/wet
         float outL = dryL * (1.0f - reverbMix) + wetL * reverbMix;
@@ -374,6 +583,8 @@ struct LushPadWidget : ModuleWidget {
         addParam(createParamCentered<RoundBlackKnob>(mm2px(Vec(centerX, 28.0f)), module, LushPad::TIMBRE_PARAM));
         addParam(createParamCentered<RoundBlackKnob>(mm2px(Vec(centerX, 50.0f)), module, LushPad::FILTER_PARAM));
         addParam(createParamCentered<RoundBlackKnob>(mm2px(Vec(centerX, 72.0f)), module, LushPad::REVERB_PARAM));
+        addParam(createParamCentered<Trimpot>(mm2px(Vec(6.5f, 72.0f)), module, LushPad::SIZE_PARAM));
+        addParam(createParamCentered<Trimpot>(mm2px(Vec(34.14f, 72.0f)), module, LushPad::DECAY_PARAM));
 
         // CV inputs
         addInput(createInputCentered<PJ301MPort>(mm2px(Vec(10.0f, 92.0f)), module, LushPad::TIMBRE_CV_INPUT));
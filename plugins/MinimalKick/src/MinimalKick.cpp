@@ -23,20 +23,35 @@ struct MinimalKick : Module {
         LIGHTS_LEN
     };
 
-    // Oscillator state
-    float phase = 0.f;
+    // Pitch sweep is evaluated every GLIDE_BLOCK samples; in between, the
+    // oscillator's per-sample angle changes linearly toward the next value
+    static const int GLIDE_BLOCK = 8;
+
+    // Oscillator state: rotating phasor (cos, sin), its per-sample rotation,
+    // and the rotation's own per-sample increment (glide within a block)
+    float phasorCos = 1.f, phasorSin = 0.f;
+    float rotCos = 1.f, rotSin = 0.f;
+    float stepCos = 1.f, stepSin = 0.f;
+    float blockOmega = 0.f;  // Angle per sample at the next block boundary
+    int blockRemaining = 0;
     float currentFrequency = 60.f;  // Default base frequency (Hz)
 
-    // Pitch envelope state
+    // Pitch envelope state (value at the next block boundary)
     float pitchEnvelopeValue = 0.f;
-    float pitchEnvelopeTime = 0.f;  // Time since trigger in seconds
 
     // Amplitude envelope state (simple AD envelope)
     float ampEnvelopeValue = 0.f;
-    float ampEnvelopeTime = 0.f;
     bool inAttackPhase = false;
     bool envelopeActive = false;
 
+    // Per-block/per-sample decay multipliers, recomputed only when their knob
+    // or the sample rate changes
+    float pitchBlockMul = 1.f;
+    float ampDecayMul = 1.f;
+    float cachedPitchDecayMs = -1.f;
+    float cachedDecayMs = -1.f;
+    float cachedSampleTime = -1.f;
+
     // Trigger detection
     dsp::SchmittTrigger trigger;
     dsp::PulseGenerator triggerLight;
@@ -64,17 +79,67 @@ struct MinimalKick : Module {
         configOutput(AUDIO_OUTPUT, "Audio");
     }
 
+    void updateDecayMultipliers(float pitchDecayMs, float decayMs, float sampleTime) {
+        if (pitchDecayMs == cachedPitchDecayMs && decayMs == cachedDecayMs && sampleTime == cachedSampleTime)
+            return;
+        cachedPitchDecayMs = pitchDecayMs;
+        cachedDecayMs = decayMs;
+        cachedSampleTime = sampleTime;
+
+        // Both envelopes fall by 60dB over their time setting
+        float pitchDecayRate = -std::log(0.001f) / (pitchDecayMs / 1000.f);
+        pitchBlockMul = std::exp(-pitchDecayRate * sampleTime * GLIDE_BLOCK);
+        float decayRate = -std::log(0.001f) / (decayMs / 1000.f);
+        ampDecayMul = std::exp(-decayRate * sampleTime);
+    }
+
+    // Angular increment per sample for a given pitch envelope value
+    float sweepOmega(float pitchEnv, float sweepSemitones, float sampleTime) {
+        float frequencyMultiplier = std::exp2(pitchEnv * sweepSemitones / 12.f);
+        return 2.f * M_PI * currentFrequency * frequencyMultiplier * sampleTime;
+    }
+
+    // Set up the next GLIDE_BLOCK samples: the rotation starts at this
+    // boundary's angle and steps linearly to the next boundary's angle
+    void startGlideBlock(float sweepSemitones, float sampleTime) {
+        float omegaStart = blockOmega;
+        pitchEnvelopeValue *= pitchBlockMul;
+        blockOmega = sweepOmega(pitchEnvelopeValue, sweepSemitones, sampleTime);
+        float delta = (blockOmega - omegaStart) / GLIDE_BLOCK;
+
+        rotCos = std::cos(omegaStart);
+        rotSin = std::sin(omegaStart);
+        stepCos = std::cos(delta);
+        stepSin = std::sin(delta);
+
+        // Renormalize the phasor against rounding drift
+        float norm = 1.5f - 0.5f * (phasorCos * phasorCos + phasorSin * phasorSin);
+        phasorCos *= norm;
+        phasorSin *= norm;
+
+        blockRemaining = GLIDE_BLOCK;
+    }
+
     void process(const ProcessArgs& args) override {
+        // Read parameters
+        float sweepSemitones = params[SWEEP_PARAM].getValue();
+        float pitchDecayMs = params[TIME_PARAM].getValue();
+        float attackMs = params[ATTACK_PARAM].getValue();
+        float decayMs = params[DECAY_PARAM].getValue();
+        float drivePercent = params[DRIVE_PARAM].getValue();
+
+        updateDecayMultipliers(pitchDecayMs, decayMs, args.sampleTime);
+
         // Check for trigger
         if (trigger.process(inputs[TRIGGER_INPUT].getVoltage(), 0.1f, 1.f)) {
             // Reset envelopes on trigger
             pitchEnvelopeValue = 1.f;
-            pitchEnvelopeTime = 0.f;
             ampEnvelopeValue = 0.f;
-            ampEnvelopeTime = 0.f;
             inAttackPhase = true;
             envelopeActive = true;
-            phase = 0.f;  // Reset oscillator phase for consistent attack
+            // Reset oscillator phase for consistent attack
+            phasorCos = 1.f;
+            phasorSin = 0.f;
 
             // Calculate base frequency from V/Oct input
             float pitch = 0.f;  // 0V = C4
@@ -85,40 +150,36 @@ struct MinimalKick : Module {
             // Shift down 3 octaves from C4 (261.63Hz / 8 ≈ 32.7Hz) + small adjustment
             currentFrequency = dsp::FREQ_C4 * std::pow(2.f, pitch - 2.1f);
 
+            // First block starts at the top of the sweep
+            blockOmega = sweepOmega(1.f, sweepSemitones, args.sampleTime);
+            blockRemaining = 0;
+
             triggerLight.trigger(0.1f);
         }
 
-        // Read parameters
-        float sweepSemitones = params[SWEEP_PARAM].getValue();
-        float pitchDecayMs = params[TIME_PARAM].getValue();
-        float attackMs = params[ATTACK_PARAM].getValue();
-        float decayMs = params[DECAY_PARAM].getValue();
-        float drivePercent = params[DRIVE_PARAM].getValue();
-
         float output = 0.f;
 
         if (envelopeActive) {
-            // Update pitch envelope (exponential decay)
-            float pitchDecaySeconds = pitchDecayMs / 1000.f;
-            float pitchDecayRate = -std::log(0.001f) / pitchDecaySeconds;
-            pitchEnvelopeValue = std::exp(-pitchDecayRate * pitchEnvelopeTime);
-            pitchEnvelopeTime += args.sampleTime;
-
-            // Calculate modulated frequency
-            float pitchOffsetSemitones = pitchEnvelopeValue * sweepSemitones;
-            float frequencyMultiplier = std::pow(2.f, pitchOffsetSemitones / 12.f);
-            float modulatedFrequency = currentFrequency * frequencyMultiplier;
+            // Pitch envelope (exponential decay) at control rate
+            if (blockRemaining == 0) {
+                startGlideBlock(sweepSemitones, args.sampleTime);
+            }
+            blockRemaining--;
 
-            // Update oscillator phase
-            phase += modulatedFrequency * args.sampleTime;
-            if (phase >= 1.f) phase -= 1.f;
+            // Rotate the phasor, then glide the rotation toward the next block
+            float c = phasorCos * rotCos - phasorSin * rotSin;
+            float s = phasorCos * rotSin + phasorSin * rotCos;
+            phasorCos = c;
+            phasorSin = s;
+            float rc = rotCos * stepCos - rotSin * stepSin;
+            rotSin = rotCos * stepSin + rotSin * stepCos;
+            rotCos = rc;
 
-            // Generate sine wave
-            float oscillatorSample = std::sin(2.f * M_PI * phase);
+            // Sine output
+            float oscillatorSample = phasorSin;
 
             // Update amplitude envelope (AD envelope)
             float attackSeconds = attackMs / 1000.f;
-            float decaySeconds = decayMs / 1000.f;
 
             if (inAttackPhase) {
                 if (attackSeconds > 0.f) {
@@ -133,8 +194,7 @@ struct MinimalKick : Module {
                 }
             } else {
                 // Decay phase (exponential decay)
-                float decayRate = -std::log(0.001f) / decaySeconds;
-                ampEnvelopeValue *= std::exp(-decayRate * args.sampleTime);
+                ampEnvelopeValue *= ampDecayMul;
 
                 // Stop envelope when below threshold
                 if (ampEnvelopeValue < 0.0001f) {
@@ -0,0 +1,175 @@
+// Compares MinimalKick's incremental envelopes and rotating-phasor sine
+// against the original per-sample std::exp/std::pow/std::sin path, over a
+// grid of knob settings at 44.1, 48 and 96 kHz, and reports the largest
+// deviation in pitch, phase, amplitude envelope and output.
+#include "../src/MinimalKick.cpp"
+#include <cstdio>
+
+Plugin* pluginInstance;
+
+// The voice as it was before the envelopes became incremental, with the
+// knobs passed in
+struct ReferenceKick {
+    float phase = 0.f;
+    float currentFrequency = 60.f;
+    float modulatedFrequency = 0.f;
+    float pitchEnvelopeTime = 0.f;
+    float ampEnvelopeValue = 0.f;
+    bool inAttackPhase = false;
+    bool envelopeActive = false;
+
+    void trigger(float pitch) {
+        pitchEnvelopeTime = 0.f;
+        ampEnvelopeValue = 0.f;
+        inAttackPhase = true;
+        envelopeActive = true;
+        phase = 0.f;
+        currentFrequency = dsp::FREQ_C4 * std::pow(2.f, pitch - 2.1f);
+    }
+
+    float process(float sampleTime, float sweepSemitones, float pitchDecayMs, float attackMs, float decayMs, float drivePercent) {
+        if (!envelopeActive) return 0.f;
+
+        float pitchDecaySeconds = pitchDecayMs / 1000.f;
+        float pitchDecayRate = -std::log(0.001f) / pitchDecaySeconds;
+        float pitchEnvelopeValue = std::exp(-pitchDecayRate * pitchEnvelopeTime);
+        pitchEnvelopeTime += sampleTime;
+
+        float pitchOffsetSemitones = pitchEnvelopeValue * sweepSemitones;
+        float frequencyMultiplier = std::pow(2.f, pitchOffsetSemitones / 12.f);
+        modulatedFrequency = currentFrequency * frequencyMultiplier;
+
+        phase += modulatedFrequency * sampleTime;
+        if (phase >= 1.f) phase -= 1.f;
+        float oscillatorSample = std::sin(2.f * M_PI * phase);
+
+        float attackSeconds = attackMs / 1000.f;
+        float decaySeconds = decayMs / 1000.f;
+        if (inAttackPhase) {
+            if (attackSeconds > 0.f) {
+                ampEnvelopeValue += sampleTime / attackSeconds;
+                if (ampEnvelopeValue >= 1.f) {
+                    ampEnvelopeValue = 1.f;
+                    inAttackPhase = false;
+                }
+            } else {
+                ampEnvelopeValue = 1.f;
+                inAttackPhase = false;
+            }
+        } else {
+            float decayRate = -std::log(0.001f) / decaySeconds;
+            ampEnvelopeValue *= std::exp(-decayRate * sampleTime);
+            if (ampEnvelopeValue < 0.0001f) {
+                ampEnvelopeValue = 0.f;
+                envelopeActive = false;
+            }
+        }
+
+        float envelopedSample = oscillatorSample * ampEnvelopeValue;
+        float gain = 1.f + (drivePercent / 100.f * 9.f);
+        return std::tanh(gain * envelopedSample) * 5.f;
+    }
+};
+
+struct Deviation {
+    double cents = 0.0;     // Instantaneous frequency
+    double degrees = 0.0;   // Oscillator phase
+    double amplitude = 0.0; // Amplitude envelope, full scale 1
+    double volts = 0.0;     // Output
+
+    void merge(const Deviation& d) {
+        cents = std::max(cents, d.cents);
+        degrees = std::max(degrees, d.degrees);
+        amplitude = std::max(amplitude, d.amplitude);
+        volts = std::max(volts, d.volts);
+    }
+};
+
+static Deviation compare(MinimalKick& kick, float sampleRate, float pitch,
+                         float sweep, float time, float attack, float decay) {
+    const float drive = 20.f;
+    kick.params[MinimalKick::SWEEP_PARAM].setValue(sweep);
+    kick.params[MinimalKick::TIME_PARAM].setValue(time);
+    kick.params[MinimalKick::ATTACK_PARAM].setValue(attack);
+    kick.params[MinimalKick::DECAY_PARAM].setValue(decay);
+    kick.params[MinimalKick::DRIVE_PARAM].setValue(drive);
+    kick.inputs[MinimalKick::VOCT_INPUT].setChannels(1);
+    kick.inputs[MinimalKick::VOCT_INPUT].setVoltage(pitch);
+    kick.inputs[MinimalKick::TRIGGER_INPUT].setChannels(1);
+
+    Module::ProcessArgs args;
+    args.sampleRate = sampleRate;
+    args.sampleTime = 1.f / sampleRate;
+    args.frame = 0;
+
+    // Let go of the previous hit so the next edge triggers
+    kick.inputs[MinimalKick::TRIGGER_INPUT].setVoltage(0.f);
+    kick.process(args);
+
+    ReferenceKick reference;
+    reference.trigger(pitch);
+    kick.inputs[MinimalKick::TRIGGER_INPUT].setVoltage(10.f);
+
+    // The trigger resets the phasor to zero phase
+    float lastCos = 1.f, lastSin = 0.f;
+    Deviation d;
+    while (reference.envelopeActive) {
+        kick.process(args);
+        float expected = reference.process(args.sampleTime, sweep, time, attack, decay, drive);
+        args.frame++;
+
+        // Angle turned this sample, and the absolute phase, both in cycles
+        double turned = std::atan2((double)kick.phasorSin * lastCos - (double)kick.phasorCos * lastSin,
+                                   (double)kick.phasorCos * lastCos + (double)kick.phasorSin * lastSin) / (2.0 * M_PI);
+        double frequency = turned * sampleRate;
+        double cycle = std::atan2(kick.phasorSin, kick.phasorCos) / (2.0 * M_PI) - reference.phase;
+        cycle -= std::round(cycle);
+
+        d.cents = std::max(d.cents, std::abs(1200.0 * std::log2(frequency / reference.modulatedFrequency)));
+        d.degrees = std::max(d.degrees, std::abs(cycle) * 360.0);
+        d.amplitude = std::max(d.amplitude, (double)std::abs(kick.ampEnvelopeValue - reference.ampEnvelopeValue));
+        d.volts = std::max(d.volts, (double)std::abs(kick.outputs[MinimalKick::AUDIO_OUTPUT].getVoltage() - expected));
+        lastCos = kick.phasorCos;
+        lastSin = kick.phasorSin;
+    }
+    return d;
+}
+
+int main() {
+    const float rates[] = {44100.f, 48000.f, 96000.f};
+    const float pitches[] = {0.f, 2.f};
+    const float sweeps[] = {0.f, 12.f, 24.f};
+    const float times[] = {5.f, 50.f, 500.f};
+    const float attacks[] = {0.f, 5.f, 50.f};
+    const float decays[] = {50.f, 400.f, 2000.f};
+
+    // Limits for the worst case over the grid. The pitch glides linearly
+    // within each GLIDE_BLOCK; only the fastest 5 ms sweep bends enough
+    // inside one block to reach tens of cents, the others stay under one.
+    const double MAX_CENTS = 50.0;
+    const double MAX_DEGREES = 3.0;
+    const double MAX_AMPLITUDE = 1e-6;
+    const double MAX_VOLTS = 0.5;
+
+    MinimalKick* kick = new MinimalKick;
+    Deviation worst;
+    printf("%-10s %-8s %10s %10s %12s %10s\n", "rate", "time", "cents", "degrees", "amplitude", "volts");
+    for (float rate : rates) {
+        for (float time : times) {
+            Deviation d;
+            for (float pitch : pitches)
+                for (float sweep : sweeps)
+                    for (float attack : attacks)
+                        for (float decay : decays)
+                            d.merge(compare(*kick, rate, pitch, sweep, time, attack, decay));
+            printf("%-10.0f %5.0f ms %10.3f %10.3f %12.2e %10.4f\n", rate, time, d.cents, d.degrees, d.amplitude, d.volts);
+            worst.merge(d);
+        }
+    }
+    delete kick;
+
+    bool ok = worst.cents <= MAX_CENTS && worst.degrees <= MAX_DEGREES
+              && worst.amplitude <= MAX_AMPLITUDE && worst.volts <= MAX_VOLTS;
+    printf("%s\n", ok ? "ok" : "FAIL: the incremental path drifts from the reference");
+    return ok ? 0 : 1;
+}
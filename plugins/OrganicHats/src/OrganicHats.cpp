@@ -1,4 +1,6 @@
 #include "plugin.hpp"
+#include "NoiseBank.hpp"
+#include "Denormals.hpp"
 
 // Simple one-pole filter for noise coloring
 struct OnePoleFilter {
@@ -9,7 +11,7 @@ struct OnePoleFilter {
     void setLowpass(float cutoff, float sampleRate) {
         float w = 2.0f * M_PI * cutoff / sampleRate;
         float cosw = std::cos(w);
-        b1 = std::sqrt(2.0f) - cosw - std::sqrt((std::sqrt(2.0f) - cosw) * (std::sqrt(2.0f) - cosw) - 1.0f);
+        b1 = 2.0f - cosw - std::sqrt((2.0f - cosw) * (2.0f - cosw) - 1.0f);
         if (b1 > 0.999f) b1 = 0.999f;
         if (b1 < 0.0f) b1 = 0.0f;
         a0 = 1.0f - b1;
@@ -20,12 +22,12 @@ struct OnePoleFilter {
     }
 
     float processLowpass(float x) {
-        y1 = a0 * x + b1 * y1;
+        y1 = a0 * x + b1 * y1 + ANTI_DENORMAL;
         return y1;
     }
 
     float processHighpass(float x) {
-        y1 = a0 * x + b1 * y1;
+        y1 = a0 * x + b1 * y1 + ANTI_DENORMAL;
         return x - y1;
     }
 
@@ -56,7 +58,7 @@ struct BandpassFilter {
     }
 
     float process(float x) {
-        float y = a0 * x + a1 * x1 + a2 * x2 - b1 * y1 - b2 * y2;
+        float y = a0 * x + a1 * x1 + a2 * x2 - b1 * y1 - b2 * y2 + ANTI_DENORMAL;
         x2 = x1;
         x1 = x;
         y2 = y1;
@@ -69,28 +71,55 @@ struct BandpassFilter {
     }
 };
 
-// Hi-hat voice
-struct HatVoice {
-    // Envelope
-    float envelope = 0.0f;
-    float decayRate = 0.0f;
-    bool active = false;
-
-    // Metallic tone (6 detuned square oscillators)
-    float phases[6] = {0.0f};
-    float frequencies[6] = {0.0f};
+// Hi-hat voice pool, stored structure-of-arrays and processed four voices per
+// float_4 lane group. Lane groups with no sounding voice are skipped.
+template <int VOICES>
+struct HatPool {
+    static_assert(VOICES % 4 == 0, "voice count must fill whole lane groups");
+    static const int GROUPS = VOICES / 4;
 
-    // Noise filter
-    OnePoleFilter noiseFilter;
-    BandpassFilter bandpass1, bandpass2;
+    // Envelope
+    alignas(16) float envelope[VOICES] = {};
+    alignas(16) float decayMul[VOICES] = {};
+
+    // Metallic tone (6 detuned square oscillators per voice)
+    alignas(16) float phases[6][VOICES] = {};
+    alignas(16) float phaseInc[6][VOICES] = {};
+
+    // Noise color one-pole (highpass = 1 selects x - y1 instead of y1)
+    alignas(16) float colorY1[VOICES] = {};
+    alignas(16) float colorA0[VOICES] = {};
+    alignas(16) float colorB1[VOICES] = {};
+    alignas(16) float highpass[VOICES] = {};
+
+    // Two shimmer bandpasses (a1 is always zero)
+    alignas(16) float bpA0[2][VOICES] = {};
+    alignas(16) float bpB1[2][VOICES] = {};
+    alignas(16) float bpB2[2][VOICES] = {};
+    alignas(16) float bpX1[2][VOICES] = {};
+    alignas(16) float bpX2[2][VOICES] = {};
+    alignas(16) float bpY1[2][VOICES] = {};
+    alignas(16) float bpY2[2][VOICES] = {};
+
+    alignas(16) float toneLevel[VOICES] = {};
+    alignas(16) float noiseLevel[VOICES] = {};
+
+    // Bit v set while voice v is sounding
+    uint32_t activeMask = 0;
+
+    bool isActive(int v) const {
+        return activeMask & (1u << v);
+    }
 
-    float toneLevel = 0.5f;
-    float noiseColor = 0.5f;
-    bool useHighpass = false;
+    void trigger(int v, float tone, float decay, float color, float sampleRate, bool isOpen) {
+        activeMask |= 1u << v;
+        envelope[v] = 1.0f;
 
-    void trigger(float tone, float decay, float color, float sampleRate, bool isOpen) {
-        active = true;
-        envelope = 1.0f;
+        // Idle lanes keep filtering noise alongside their group, so start clean
+        colorY1[v] = 0.0f;
+        for (int b = 0; b < 2; b++) {
+            bpX1[b][v] = bpX2[b][v] = bpY1[b][v] = bpY2[b][v] = 0.0f;
+        }
 
         // Decay time: closed = 20-150ms, open = 100-800ms
         float decayTime;
@@ -99,91 +128,108 @@ struct HatVoice {
         } else {
             decayTime = 0.02f + decay * 0.13f;  // 20-150ms
         }
-        decayRate = 1.0f / (decayTime * sampleRate);
+        decayMul[v] = 1.0f - 1.0f / (decayTime * sampleRate);
 
         // Metallic frequencies based on tone
         // Classic 808 hat ratios: 205, 302, 369, 522, 565, 808 Hz (roughly)
+        const float ratios[6] = {1.0f, 1.47f, 1.80f, 2.55f, 2.76f, 3.94f};
         float baseFreq = 200.0f + tone * 600.0f;  // 200-800 Hz base
-        frequencies[0] = baseFreq * 1.0f;
-        frequencies[1] = baseFreq * 1.47f;
-        frequencies[2] = baseFreq * 1.80f;
-        frequencies[3] = baseFreq * 2.55f;
-        frequencies[4] = baseFreq * 2.76f;
-        frequencies[5] = baseFreq * 3.94f;
-
-        // Random phase for natural sound
         for (int i = 0; i < 6; i++) {
-            phases[i] = random::uniform();
+            phaseInc[i][v] = baseFreq * ratios[i] / sampleRate;
+            // Random phase for natural sound
+            phases[i][v] = random::uniform();
         }
 
         // Noise color: 0 = dark (lowpass), 1 = bright (highpass)
-        noiseColor = color;
-        useHighpass = color > 0.5f;
-
-        float cutoff;
+        OnePoleFilter colorFilter;
+        bool useHighpass = color > 0.5f;
         if (useHighpass) {
-            cutoff = 2000.0f + (color - 0.5f) * 2.0f * 8000.0f;  // 2k-10k Hz
-            noiseFilter.setHighpass(cutoff, sampleRate);
+            float cutoff = 2000.0f + (color - 0.5f) * 2.0f * 8000.0f;  // 2k-10k Hz
+            colorFilter.setHighpass(cutoff, sampleRate);
         } else {
-            cutoff = 500.0f + color * 2.0f * 4500.0f;  // 500-5000 Hz
-            noiseFilter.setLowpass(cutoff, sampleRate);
+            float cutoff = 500.0f + color * 2.0f * 4500.0f;  // 500-5000 Hz
+            colorFilter.setLowpass(cutoff, sampleRate);
         }
+        colorA0[v] = colorFilter.a0;
+        colorB1[v] = colorFilter.b1;
+        highpass[v] = useHighpass ? 1.0f : 0.0f;
 
         // Bandpass filters for multi-band noise
-        bandpass1.setParams(3000.0f + tone * 3000.0f, 2.0f, sampleRate);
-        bandpass2.setParams(8000.0f + tone * 4000.0f, 1.5f, sampleRate);
+        BandpassFilter bandpass[2];
+        bandpass[0].setParams(3000.0f + tone * 3000.0f, 2.0f, sampleRate);
+        bandpass[1].setParams(8000.0f + tone * 4000.0f, 1.5f, sampleRate);
+        for (int b = 0; b < 2; b++) {
+            bpA0[b][v] = bandpass[b].a0;
+            bpB1[b][v] = bandpass[b].b1;
+            bpB2[b][v] = bandpass[b].b2;
+        }
 
-        toneLevel = 0.3f + tone * 0.4f;  // More tone at higher settings
+        toneLevel[v] = 0.3f + tone * 0.4f;  // More tone at higher settings
+        noiseLevel[v] = 1.0f - toneLevel[v] * 0.5f;
     }
 
-    void choke() {
+    void choke(int v, float sampleRate) {
         // Quick fade out instead of abrupt stop
-        decayRate = 1.0f / (0.005f * 44100.0f);  // 5ms choke
+        decayMul[v] = 1.0f - 1.0f / (0.005f * sampleRate);  // 5ms choke
     }
 
-    float process(float sampleRate) {
-        if (!active) return 0.0f;
-
-        // Generate metallic tone (sum of square waves)
-        float tone = 0.0f;
-        for (int i = 0; i < 6; i++) {
-            phases[i] += frequencies[i] / sampleRate;
-            if (phases[i] >= 1.0f) phases[i] -= 1.0f;
-            // Square wave with soft edges
-            float sq = phases[i] < 0.5f ? 1.0f : -1.0f;
-            tone += sq * (1.0f / 6.0f);
-        }
-
-        // Generate noise
-        float noise = random::uniform() * 2.0f - 1.0f;
-
-        // Filter noise
-        float filteredNoise;
-        if (useHighpass) {
-            filteredNoise = noiseFilter.processHighpass(noise);
-        } else {
-            filteredNoise = noiseFilter.processLowpass(noise);
-        }
-
-        // Add bandpass filtered noise for shimmer
-        float bp1 = bandpass1.process(noise);
-        float bp2 = bandpass2.process(noise);
-        filteredNoise = filteredNoise * 0.6f + bp1 * 0.25f + bp2 * 0.15f;
-
-        // Mix tone and noise
-        float mix = tone * toneLevel + filteredNoise * (1.0f - toneLevel * 0.5f);
-
-        // Apply envelope
-        float output = mix * envelope * 0.7f;
+    // Returns the summed output of all voices. noise holds one sample per voice.
+    float process(const float* noise) {
+        using simd::float_4;
+        float_4 sum = 0.0f;
+
+        for (int g = 0; g < GROUPS; g++) {
+            if (!((activeMask >> (4 * g)) & 0xF)) continue;
+            int o = 4 * g;
+
+            // Generate metallic tone (sum of square waves)
+            float_4 tone = 0.0f;
+            for (int i = 0; i < 6; i++) {
+                float_4 ph = float_4::load(&phases[i][o]) + float_4::load(&phaseInc[i][o]);
+                ph -= simd::ifelse(ph >= 1.0f, 1.0f, 0.0f);
+                ph.store(&phases[i][o]);
+                tone += simd::ifelse(ph < 0.5f, 1.0f / 6.0f, -1.0f / 6.0f);
+            }
 
-        // Exponential decay
-        envelope -= envelope * decayRate;
-        if (envelope < 0.001f) {
-            active = false;
-            envelope = 0.0f;
+            float_4 x = float_4::load(&noise[o]);
+
+            // Color one-pole: y1 for lowpass lanes, x - y1 for highpass lanes
+            float_4 y1 = float_4::load(&colorA0[o]) * x + float_4::load(&colorB1[o]) * float_4::load(&colorY1[o])
+                + ANTI_DENORMAL;
+            y1.store(&colorY1[o]);
+            float_4 filteredNoise = y1 + float_4::load(&highpass[o]) * (x - 2.0f * y1);
+
+            // Add bandpass filtered noise for shimmer
+            float_4 bp[2];
+            for (int b = 0; b < 2; b++) {
+                float_4 x2 = float_4::load(&bpX2[b][o]);
+                float_4 yb1 = float_4::load(&bpY1[b][o]);
+                float_4 yb2 = float_4::load(&bpY2[b][o]);
+                bp[b] = float_4::load(&bpA0[b][o]) * (x - x2)
+                    - float_4::load(&bpB1[b][o]) * yb1
+                    - float_4::load(&bpB2[b][o]) * yb2
+                    + ANTI_DENORMAL;
+                float_4::load(&bpX1[b][o]).store(&bpX2[b][o]);
+                x.store(&bpX1[b][o]);
+                yb1.store(&bpY2[b][o]);
+                bp[b].store(&bpY1[b][o]);
+            }
+            filteredNoise = filteredNoise * 0.6f + bp[0] * 0.25f + bp[1] * 0.15f;
+
+            // Mix tone and noise, apply envelope
+            float_4 env = float_4::load(&envelope[o]);
+            float_4 mix = tone * float_4::load(&toneLevel[o]) + filteredNoise * float_4::load(&noiseLevel[o]);
+            sum += mix * env;
+
+            // Exponential decay, retire voices below -60dB
+            env *= float_4::load(&decayMul[o]);
+            float_4 done = env < 0.001f;
+            env = simd::ifelse(done, 0.0f, env);
+            env.store(&envelope[o]);
+            activeMask &= ~((uint32_t)simd::movemask(done) << o);
         }
 
-        return output;
+        return (sum[0] + sum[1] + sum[2] + sum[3]) * 0.7f;
     }
 };
 
@@ -218,13 +264,16 @@ struct OrganicHats : Module {
     };
 
     // Voices - 4 closed, 8 open (open hats ring longer)
+    // Pool slots: closed voices first, then open voices
     static const int NUM_CLOSED_VOICES = 4;
     static const int NUM_OPEN_VOICES = 8;
-    HatVoice closedVoices[NUM_CLOSED_VOICES];
-    HatVoice openVoices[NUM_OPEN_VOICES];
+    HatPool<NUM_CLOSED_VOICES + NUM_OPEN_VOICES> voices;
     int nextClosedVoice = 0;
     int nextOpenVoice = 0;
 
+    // One noise stream per pool slot
+    NoiseBank<NUM_CLOSED_VOICES + NUM_OPEN_VOICES> noise;
+
     // Trigger detection
     dsp::SchmittTrigger closedTrigger;
     dsp::SchmittTrigger openTrigger;
@@ -260,6 +309,8 @@ struct OrganicHats : Module {
     }
 
     void process(const ProcessArgs& args) override {
+        DenormalGuard denormalGuard;
+
         float sampleRate = args.sampleRate;
 
         // Get parameters with CV modulation
@@ -292,33 +343,27 @@ struct OrganicHats : Module {
         if (closedTrigger.process(inputs[CLOSED_TRIG_INPUT].getVoltage(), 0.1f, 2.0f)) {
             // Closed hi-hat chokes all open hats
             for (int i = 0; i < NUM_OPEN_VOICES; i++) {
-                if (openVoices[i].active) {
-                    openVoices[i].choke();
+                if (voices.isActive(NUM_CLOSED_VOICES + i)) {
+                    voices.choke(NUM_CLOSED_VOICES + i, sampleRate);
                 }
             }
 
             // Trigger new closed hat
-            closedVoices[nextClosedVoice].trigger(closedTone, closedDecay, closedColor, sampleRate, false);
+            voices.trigger(nextClosedVoice, closedTone, closedDecay, closedColor, sampleRate, false);
             nextClosedVoice = (nextClosedVoice + 1) % NUM_CLOSED_VOICES;
             closedLight = 1.0f;
         }
 
         if (openTrigger.process(inputs[OPEN_TRIG_INPUT].getVoltage(), 0.1f, 2.0f)) {
             // Trigger new open hat
-            openVoices[nextOpenVoice].trigger(openTone, openRelease, openColor, sampleRate, true);
+            voices.trigger(NUM_CLOSED_VOICES + nextOpenVoice, openTone, openRelease, openColor, sampleRate, true);
             nextOpenVoice = (nextOpenVoice + 1) % NUM_OPEN_VOICES;
             openLight = 1.0f;
         }
 
         // Process all voices
-        float output = 0.0f;
-
-        for (int i = 0; i < NUM_CLOSED_VOICES; i++) {
-            output += closedVoices[i].process(sampleRate);
-        }
-        for (int i = 0; i < NUM_OPEN_VOICES; i++) {
-            output += openVoices[i].process(sampleRate);
-        }
+        noise.step();
+        float output = voices.process(noise.white[noise.frame]);
 
         // Soft clip output
         output = std::tanh(output);
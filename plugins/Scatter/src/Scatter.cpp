@@ -1,4 +1,5 @@
 #include "plugin.hpp"
+#include "Denormals.hpp"
 
 // Delay buffer
 struct ScatterBuffer {
@@ -183,6 +184,8 @@ struct Scatter : Module {
     }
 
     void process(const ProcessArgs& args) override {
+        DenormalGuard denormalGuard;
+
         float sampleRate = args.sampleRate;
 
         // Get parameters
@@ -216,7 +219,7 @@ struct Scatter : Module {
         float inputMono = (inputL + inputR) * 0.5f;
 
         // Write input + feedback to buffer
-        delayBuffer.write(inputMono + (feedbackL + feedbackR) * 0.5f * feedback);
+        delayBuffer.write(inputMono + (feedbackL + feedbackR) * 0.5f * feedback + ANTI_DENORMAL);
 
         // Grain scheduling
         float densityNorm = std::max(0.01f, density);
@@ -1,4 +1,7 @@
 #include "plugin.hpp"
+#include "NoiseBank.hpp"
+#include "Oversampler.hpp"
+#include "Denormals.hpp"
 
 // Delay line for wow/flutter
 struct TapeDelayLine {
@@ -44,6 +47,259 @@ struct TapeDelayLine {
     }
 };
 
+// Antiderivative-antialiased tanh (first or second order).
+// The antiderivatives grow like x^2, so the differences are taken in double.
+struct TanhADAA {
+    static constexpr double EPS = 1e-5;
+
+    double x1 = 0.0, x2 = 0.0;  // Previous two inputs
+    double f1Prev = 0.0;        // F1(x1)
+    double f2Prev = 0.0;        // F2(x1)
+    double d1Prev = 0.0;        // First-order difference between x2 and x1
+
+    void reset() {
+        x1 = x2 = 0.0;
+        f1Prev = f2Prev = d1Prev = 0.0;
+    }
+
+    // F1(x) = log(cosh(x)), written to stay finite for large |x|
+    static double logCosh(double x) {
+        double a = std::abs(x);
+        return a + std::log1p(std::exp(-2.0 * a)) - M_LN2;
+    }
+
+    // Li2(-x) for 0 <= x <= 1
+    static double dilogNeg(double x) {
+        if (x < 1e-16) return -x;
+        if (x <= 0.5) {
+            double term = -x, sum = 0.0;
+            for (int k = 1; k < 64 && std::abs(term) > 1e-17 * k * k; k++) {
+                sum += term / (k * k);
+                term *= -x;
+            }
+            return sum;
+        }
+        // Landen: Li2(-x) = -log^2(1 + x) / 2 - Li2(x / (1 + x))
+        double z = x / (1.0 + x), term = z, sum = 0.0;
+        for (int k = 1; k < 64 && term > 1e-17 * k * k; k++) {
+            sum += term / (k * k);
+            term *= z;
+        }
+        double l = std::log1p(x);
+        return -0.5 * l * l - sum;
+    }
+
+    // F2(x) = integral of log(cosh(t)) from 0 to x (odd in x)
+    static double logCoshIntegral(double x) {
+        double a = std::abs(x);
+        double f = 0.5 * a * a - M_LN2 * a + 0.5 * dilogNeg(std::exp(-2.0 * a)) + M_PI * M_PI / 24.0;
+        return x < 0.0 ? -f : f;
+    }
+
+    float processFirstOrder(float in) {
+        double x = in;
+        double f1 = logCosh(x);
+        double dx = x - x1;
+        double y = (std::abs(dx) < EPS) ? std::tanh(0.5 * (x + x1)) : (f1 - f1Prev) / dx;
+        x1 = x;
+        f1Prev = f1;
+        return (float)y;
+    }
+
+    float processSecondOrder(float in) {
+        double x = in;
+        double f2 = logCoshIntegral(x);
+
+        // First-order difference of F2 between x1 and x
+        double dx = x - x1;
+        double d1 = (std::abs(dx) < EPS) ? logCosh(0.5 * (x + x1)) : (f2 - f2Prev) / dx;
+
+        double y;
+        double span = x - x2;
+        if (std::abs(span) >= EPS) {
+            y = 2.0 * (d1 - d1Prev) / span;
+        } else {
+            // x ~ x2: expand around their midpoint
+            double mid = 0.5 * (x + x2);
+            double delta = mid - x1;
+            if (std::abs(delta) < EPS) {
+                y = std::tanh(0.5 * (mid + x1));
+            } else {
+                y = 2.0 / delta * (logCosh(mid) + (f2Prev - logCoshIntegral(mid)) / delta);
+            }
+        }
+
+        x2 = x1;
+        x1 = x;
+        f2Prev = f2;
+        d1Prev = d1;
+        return (float)y;
+    }
+};
+
+// Four sine LFOs as rotating (cos, sin) pairs: one complex multiply per
+// sample instead of a std::sin call each
+struct QuadratureLFO4 {
+    simd::float_4 c = 1.0f, s = 0.0f;
+    simd::float_4 rotCos = 1.0f, rotSin = 0.0f;
+
+    void setPhases(simd::float_4 phase) {
+        for (int i = 0; i < 4; i++) {
+            c[i] = std::cos(phase[i]);
+            s[i] = std::sin(phase[i]);
+        }
+    }
+
+    // Radians per sample
+    void setIncrements(simd::float_4 inc) {
+        for (int i = 0; i < 4; i++) {
+            rotCos[i] = std::cos(inc[i]);
+            rotSin[i] = std::sin(inc[i]);
+        }
+    }
+
+    // Pull the radius back to 1; rounding drifts it slowly
+    void normalize() {
+        simd::float_4 g = 1.5f - 0.5f * (c * c + s * s);
+        c *= g;
+        s *= g;
+    }
+
+    // Current sine values, then advance
+    simd::float_4 step() {
+        simd::float_4 out = s;
+        simd::float_4 nextC = c * rotCos - s * rotSin;
+        s = s * rotCos + c * rotSin;
+        c = nextC;
+        return out;
+    }
+};
+
+// Tape damage as a precomputed timeline of piecewise-linear gain segments.
+// Level wobble, dropouts and crinkles are all scheduled ahead of time into a
+// small segment queue at control rate, from a seeded generator, so the audio
+// path only steps one ramp and applies a single multiply.
+struct TapeDamage {
+    struct Segment {
+        int length;
+        float slope;
+        float endGain;
+    };
+
+    // One scheduled event is at most 13 segments. Only the next event is
+    // queued, so AGE changes take effect within about half a second.
+    static const int QUEUE_SIZE = 32;
+
+    Segment queue[QUEUE_SIZE];
+    int head = 0;
+    int count = 0;
+
+    // Playback of the current segment
+    float gain = 1.0f;
+    float slope = 0.0f;
+    float endGain = 1.0f;
+    int remaining = 0;
+
+    // Scheduler
+    uint32_t seed = 1;
+    uint32_t rng = 1;
+    float tailGain = 1.0f;  // Gain at the end of the last queued segment
+    float sampleRate = 0.0f;  // Rate the queued lengths are in
+
+    void setSeed(uint32_t s) {
+        seed = s;
+        rng = s ? s : 0x6D2B79F5u;
+        head = 0;
+        count = 0;
+        remaining = 0;
+        gain = endGain = tailGain = 1.0f;
+        slope = 0.0f;
+    }
+
+    float uniform() {
+        rng ^= rng << 13;
+        rng ^= rng >> 17;
+        rng ^= rng << 5;
+        return (rng >> 8) * (1.0f / 16777216.0f);
+    }
+
+    void push(float seconds, float target, float sampleRate) {
+        int length = std::max(1, (int)(seconds * sampleRate));
+        Segment& seg = queue[(head + count) % QUEUE_SIZE];
+        seg.length = length;
+        seg.slope = (target - tailGain) / length;
+        seg.endGain = target;
+        tailGain = target;
+        count++;
+    }
+
+    // Queue one wobble gap and, depending on age, the event that follows it
+    void scheduleNext(float age, float sampleRate) {
+        // Level wobble: drift to a new level (up to about -1 dB) over the gap
+        float gap = 0.1f + uniform() * 0.3f;
+        float level = 1.0f - age * 0.1f * uniform();
+        push(gap, level, sampleRate);
+
+        // Dropouts at ~0.2 * age per second, crinkles three times as often
+        float r = uniform();
+        float pDropout = age * 0.2f * gap;
+        float pCrinkle = age * 0.6f * gap;
+        if (r < pDropout) {
+            // Fast fall, a drifting hold at 10-30%, fast recovery
+            push(0.0075f, level * (0.1f + uniform() * 0.2f), sampleRate);
+            push(0.05f + uniform() * 0.1f, level * (0.1f + uniform() * 0.2f), sampleRate);
+            push(0.0075f, level, sampleRate);
+        } else if (r < pDropout + pCrinkle) {
+            // A few short dips
+            int dips = 3 + (int)(uniform() * 4.0f);
+            for (int i = 0; i < dips; i++) {
+                push(0.002f + uniform() * 0.002f, level * (0.5f + uniform() * 0.35f), sampleRate);
+                push(0.002f + uniform() * 0.002f, level, sampleRate);
+            }
+        }
+    }
+
+    // Stretches the segment in progress and those queued to a new rate
+    void rescale(float ratio) {
+        if (remaining > 0) {
+            remaining = std::max(1, (int)(remaining * ratio));
+            slope = (endGain - gain) / remaining;
+        }
+        for (int i = 0; i < count; i++) {
+            Segment& seg = queue[(head + i) % QUEUE_SIZE];
+            int length = std::max(1, (int)(seg.length * ratio));
+            seg.slope *= (float)seg.length / length;
+            seg.length = length;
+        }
+    }
+
+    // Control rate: schedule the next event once the queue runs dry
+    void refill(float age, float sampleRate) {
+        if (this->sampleRate > 0.0f && sampleRate != this->sampleRate) {
+            rescale(sampleRate / this->sampleRate);
+        }
+        this->sampleRate = sampleRate;
+        if (count == 0) {
+            scheduleNext(age, sampleRate);
+        }
+    }
+
+    float process() {
+        if (remaining <= 0) {
+            if (count == 0) return gain;
+            const Segment& seg = queue[head];
+            head = (head + 1) % QUEUE_SIZE;
+            count--;
+            remaining = seg.length;
+            slope = seg.slope;
+            endGain = seg.endGain;
+        }
+        gain += slope;
+        if (--remaining == 0) gain = endGain;
+        return gain;
+    }
+};
+
 struct TapeAge : Module {
     enum ParamId {
         INPUT_PARAM,
@@ -71,22 +327,51 @@ struct TapeAge : Module {
 
     TapeDelayLine delayLine;
 
-    // LFO phases for wow/flutter
-    float wowPhaseL = 0.0f, wowPhaseR = 0.0f;
-    float flutterPhaseL = 0.0f, flutterPhaseR = 0.0f;
+    // Wow/flutter LFOs: wow L, wow R, flutter L, flutter R
+    QuadratureLFO4 lfo;
+
+    // Knob-derived values, refreshed every CONTROL_INTERVAL samples
+    static const int CONTROL_INTERVAL = 32;
+    int controlCounter = 0;
+    float age = 0.0f;
+    float mix = 1.0f;
+    float inputGain = 1.0f;
+    float outputGain = 1.0f;
+    float driveGain = 1.0f;
+    float makeupGain = 1.0f;
+    float modDepth = 0.0f;
+    float baseDelay = 0.0f;
+    float ageCoef = 1.0f;
+    float noiseCoef = 1.0f;
+    float noiseGain = 0.0f;
 
     // Noise filter state
     float noiseFilterL = 0.0f, noiseFilterR = 0.0f;
 
-    // Dropout state
-    int dropoutCountdown = 4800;
-    bool inDropout = false;
-    int dropoutRemaining = 0;
-    float dropoutEnv = 1.0f;
+    // Hiss L/R
+    enum NoiseStream { HISS_L_NOISE, HISS_R_NOISE, NOISE_STREAMS };
+    NoiseBank<NOISE_STREAMS> noise;
+
+    // Dropouts, crinkles and level wobble
+    TapeDamage damage;
+    uint32_t damageSeed = 0;  // Applied to `damage` at the next control update
 
     // Highpass for DC blocking
     float dcBlockL = 0.0f, dcBlockR = 0.0f;
 
+    // Saturation antialiasing
+    enum SaturationMode {
+        SATURATION_PLAIN,
+        SATURATION_ADAA1,
+        SATURATION_ADAA2,
+        SATURATION_OVERSAMPLE_2X,
+        SATURATION_OVERSAMPLE_4X,
+        SATURATION_MODES
+    };
+    int saturationMode = SATURATION_PLAIN;  // Previous sound; ADAA and oversampling are in the menu
+    TanhADAA adaaL, adaaR;
+    Oversampler<simd::float_4> oversampler;  // Left and right in lanes 0 and 1
+
     TapeAge() {
         config(PARAMS_LEN, INPUTS_LEN, OUTPUTS_LEN, LIGHTS_LEN);
 
@@ -105,28 +390,79 @@ struct TapeAge : Module {
         configOutput(RIGHT_OUTPUT, "Right");
 
         // Randomize LFO phases
-        wowPhaseL = random::uniform() * 2.0f * M_PI;
-        wowPhaseR = random::uniform() * 2.0f * M_PI;
-        flutterPhaseL = random::uniform() * 2.0f * M_PI;
-        flutterPhaseR = random::uniform() * 2.0f * M_PI;
+        lfo.setPhases(simd::float_4(random::uniform(), random::uniform(), random::uniform(), random::uniform()) * (2.0f * M_PI));
+
+        damageSeed = random::u32();
+        damage.setSeed(damageSeed);
+    }
+
+    void setSaturationMode(int mode) {
+        saturationMode = clamp(mode, 0, SATURATION_MODES - 1);
+        oversampler.setFactor(saturationMode == SATURATION_OVERSAMPLE_4X ? 4 : saturationMode == SATURATION_OVERSAMPLE_2X ? 2 : 1);
+        adaaL.reset();
+        adaaR.reset();
+    }
+
+    json_t* dataToJson() override {
+        json_t* rootJ = json_object();
+        json_object_set_new(rootJ, "saturationMode", json_integer(saturationMode));
+        json_object_set_new(rootJ, "damageSeed", json_integer(damageSeed));
+        return rootJ;
+    }
+
+    void dataFromJson(json_t* rootJ) override {
+        json_t* modeJ = json_object_get(rootJ, "saturationMode");
+        if (modeJ) setSaturationMode(json_integer_value(modeJ));
+        json_t* seedJ = json_object_get(rootJ, "damageSeed");
+        if (seedJ) damageSeed = (uint32_t)json_integer_value(seedJ);
+    }
+
+    void saturate(float& wetL, float& wetR, float driveGain) {
+        switch (saturationMode) {
+            case SATURATION_ADAA1:
+                wetL = adaaL.processFirstOrder(wetL * driveGain);
+                wetR = adaaR.processFirstOrder(wetR * driveGain);
+                break;
+            case SATURATION_ADAA2:
+                wetL = adaaL.processSecondOrder(wetL * driveGain);
+                wetR = adaaR.processSecondOrder(wetR * driveGain);
+                break;
+            case SATURATION_OVERSAMPLE_2X:
+            case SATURATION_OVERSAMPLE_4X: {
+                simd::float_4 buffer[Oversampler<simd::float_4>::MAX_FACTOR];
+                oversampler.upsample(simd::float_4(wetL, wetR, 0.0f, 0.0f) * driveGain, buffer);
+                for (int i = 0; i < oversampler.factor; i++) {
+                    buffer[i][0] = std::tanh(buffer[i][0]);
+                    buffer[i][1] = std::tanh(buffer[i][1]);
+                }
+                simd::float_4 out = oversampler.downsample(buffer);
+                wetL = out[0];
+                wetR = out[1];
+                break;
+            }
+            default:
+                wetL = std::tanh(wetL * driveGain);
+                wetR = std::tanh(wetR * driveGain);
+                break;
+        }
     }
 
     void onReset() override {
         delayLine.clear();
+        adaaL.reset();
+        adaaR.reset();
+        oversampler.reset();
         noiseFilterL = noiseFilterR = 0.0f;
         dcBlockL = dcBlockR = 0.0f;
-        dropoutEnv = 1.0f;
-        inDropout = false;
+        damage.setSeed(damage.seed);
     }
 
-    void process(const ProcessArgs& args) override {
-        float sampleRate = args.sampleRate;
-
+    void updateControl(float sampleRate) {
         // Get parameters
         float inputDB = params[INPUT_PARAM].getValue();
         float drive = params[DRIVE_PARAM].getValue();
-        float age = params[AGE_PARAM].getValue();
-        float mix = params[MIX_PARAM].getValue();
+        age = params[AGE_PARAM].getValue();
+        mix = params[MIX_PARAM].getValue();
         float outputDB = params[OUTPUT_PARAM].getValue();
 
         // CV modulation
@@ -140,11 +476,10 @@ struct TapeAge : Module {
         }
 
         // Calculate gains
-        float inputGain = std::pow(10.0f, inputDB / 20.0f);
-        float outputGain = std::pow(10.0f, outputDB / 20.0f);
+        inputGain = std::pow(10.0f, inputDB / 20.0f);
+        outputGain = std::pow(10.0f, outputDB / 20.0f);
 
         // Calculate drive gain (progressive curve)
-        float driveGain;
         if (drive <= 0.3f) {
             driveGain = 1.0f + (drive / 0.3f);
         } else if (drive <= 0.7f) {
@@ -152,7 +487,39 @@ struct TapeAge : Module {
         } else {
             driveGain = 8.0f + ((drive - 0.7f) / 0.3f) * 12.0f;
         }
-        float makeupGain = 1.0f / std::sqrt(driveGain);
+        makeupGain = 1.0f / std::sqrt(driveGain);
+
+        // Wow/flutter rates and depth (±25 cents max)
+        float wowFreq = 1.0f + age;  // 1-2 Hz
+        float flutterFreq = 6.0f;
+        float wowInc = (wowFreq * 2.0f * M_PI) / sampleRate;
+        float flutterInc = (flutterFreq * 2.0f * M_PI) / sampleRate;
+        lfo.setIncrements(simd::float_4(wowInc, wowInc, flutterInc, flutterInc));
+        lfo.normalize();
+        modDepth = age * 0.0145f;  // ~25 cents
+        baseDelay = sampleRate * 0.05f;  // 50ms
+
+        // Age lowpass: 20kHz -> 8kHz based on age
+        float cutoff = 20000.0f * std::pow(0.4f, age);
+        ageCoef = 1.0f - std::exp(-2.0f * M_PI * cutoff / sampleRate);
+
+        // Tape noise
+        noiseGain = age * 0.001f;  // -60dB at full age
+        noiseCoef = 1.0f - std::exp(-2.0f * M_PI * 8000.0f / sampleRate);
+
+        if (damageSeed != damage.seed) damage.setSeed(damageSeed);
+        damage.refill(age, sampleRate);
+    }
+
+    void process(const ProcessArgs& args) override {
+        DenormalGuard denormalGuard;
+
+        float sampleRate = args.sampleRate;
+
+        if (controlCounter-- <= 0) {
+            controlCounter = CONTROL_INTERVAL - 1;
+            updateControl(sampleRate);
+        }
 
         // Get input
         float dryL = inputs[LEFT_INPUT].getVoltage() / 5.0f;
@@ -164,27 +531,19 @@ struct TapeAge : Module {
         float wetR = dryR * inputGain;
 
         // === Saturation ===
-        wetL = std::tanh(wetL * driveGain) * makeupGain;
-        wetR = std::tanh(wetR * driveGain) * makeupGain;
+        saturate(wetL, wetR, driveGain);
+        wetL *= makeupGain;
+        wetR *= makeupGain;
 
         // === Wow/Flutter (pitch modulation via delay) ===
-        float wowFreq = 1.0f + age;  // 1-2 Hz
-        float flutterFreq = 6.0f;
-        float wowInc = (wowFreq * 2.0f * M_PI) / sampleRate;
-        float flutterInc = (flutterFreq * 2.0f * M_PI) / sampleRate;
-
-        // Modulation depth based on age (±25 cents max)
-        float modDepth = age * 0.0145f;  // ~25 cents
-
-        // Calculate combined modulation
-        float modL = std::sin(wowPhaseL) + std::sin(flutterPhaseL) * 0.2f;
-        float modR = std::sin(wowPhaseR) + std::sin(flutterPhaseR) * 0.2f;
+        simd::float_4 lfoOut = lfo.step();
+        float modL = lfoOut[0] + lfoOut[2] * 0.2f;
+        float modR = lfoOut[1] + lfoOut[3] * 0.2f;
 
         // Write to delay line
         delayLine.write(wetL, wetR);
 
         // Calculate modulated delay (base 50ms + modulation)
-        float baseDelay = sampleRate * 0.05f;
         float delayL = baseDelay + modL * modDepth * baseDelay;
         float delayR = baseDelay + modR * modDepth * baseDelay;
 
@@ -192,61 +551,27 @@ struct TapeAge : Module {
         wetL = delayLine.readL(delayL);
         wetR = delayLine.readR(delayR);
 
-        // Advance LFO phases
-        wowPhaseL += wowInc;
-        wowPhaseR += wowInc;
-        flutterPhaseL += flutterInc;
-        flutterPhaseR += flutterInc;
-        if (wowPhaseL >= 2.0f * M_PI) wowPhaseL -= 2.0f * M_PI;
-        if (wowPhaseR >= 2.0f * M_PI) wowPhaseR -= 2.0f * M_PI;
-        if (flutterPhaseL >= 2.0f * M_PI) flutterPhaseL -= 2.0f * M_PI;
-        if (flutterPhaseR >= 2.0f * M_PI) flutterPhaseR -= 2.0f * M_PI;
-
         // === Age-dependent lowpass (high frequency rolloff) ===
         if (age > 0.01f) {
-            // Simple one-pole lowpass: 20kHz -> 8kHz based on age
-            float cutoff = 20000.0f * std::pow(0.4f, age);
-            float coef = 1.0f - std::exp(-2.0f * M_PI * cutoff / sampleRate);
-            dcBlockL += coef * (wetL - dcBlockL);
-            dcBlockR += coef * (wetR - dcBlockR);
+            dcBlockL += ageCoef * (wetL - dcBlockL) + ANTI_DENORMAL;
+            dcBlockR += ageCoef * (wetR - dcBlockR) + ANTI_DENORMAL;
             wetL = dcBlockL;
             wetR = dcBlockR;
         }
 
-        // === Dropout events ===
-        dropoutCountdown--;
-        if (dropoutCountdown <= 0) {
-            dropoutCountdown = (int)(sampleRate * 0.1f);  // Check every 100ms
+        noise.step();
 
-            if (random::uniform() < age * 0.02f && !inDropout) {
-                inDropout = true;
-                dropoutRemaining = (int)(sampleRate * (0.05f + random::uniform() * 0.1f));
-            }
-        }
-
-        // Process dropout envelope
-        float envRate = 1.0f / (sampleRate * 0.0075f);  // 7.5ms attack/release
-        if (inDropout && dropoutRemaining > 0) {
-            float target = 0.1f + random::uniform() * 0.2f;
-            if (dropoutEnv > target) dropoutEnv -= envRate;
-            dropoutRemaining--;
-            if (dropoutRemaining <= 0) inDropout = false;
-        } else if (dropoutEnv < 1.0f) {
-            dropoutEnv += envRate;
-            if (dropoutEnv > 1.0f) dropoutEnv = 1.0f;
-        }
-
-        wetL *= dropoutEnv;
-        wetR *= dropoutEnv;
+        // === Tape damage (dropouts, crinkles, wobble) ===
+        float damageGain = damage.process();
+        wetL *= damageGain;
+        wetR *= damageGain;
 
         // === Tape noise ===
-        float noiseGain = age * 0.001f;  // -60dB at full age
         if (noiseGain > 0.0f) {
-            float noiseCoef = 1.0f - std::exp(-2.0f * M_PI * 8000.0f / sampleRate);
-            float noiseL = random::uniform() * 2.0f - 1.0f;
-            float noiseR = random::uniform() * 2.0f - 1.0f;
-            noiseFilterL += noiseCoef * (noiseL - noiseFilterL);
-            noiseFilterR += noiseCoef * (noiseR - noiseFilterR);
+            float noiseL = noise.getWhite(HISS_L_NOISE);
+            float noiseR = noise.getWhite(HISS_R_NOISE);
+            noiseFilterL += noiseCoef * (noiseL - noiseFilterL) + ANTI_DENORMAL;
+            noiseFilterR += noiseCoef * (noiseR - noiseFilterR) + ANTI_DENORMAL;
             wetL += noiseFilterL * noiseGain;
             wetR += noiseFilterR * noiseGain;
         }
@@ -297,6 +622,20 @@ struct TapeAgeWidget : ModuleWidget {
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(30.0f, ioY)), module, TapeAge::LEFT_OUTPUT));
         addOutput(createOutputCentered<PJ301MPort>(mm2px(Vec(38.0f, ioY)), module, TapeAge::RIGHT_OUTPUT));
     }
+
+    void appendContextMenu(Menu* menu) override {
+        TapeAge* module = getModule<TapeAge>();
+
+        menu->addChild(new MenuSeparator);
+        menu->addChild(createIndexSubmenuItem("Saturation antialiasing",
+            {"Off", "ADAA (1st order)", "ADAA (2nd order)", "2x oversampling", "4x oversampling"},
+            [=]() { return (size_t)module->saturationMode; },
+            [=](size_t mode) { module->setSaturationMode((int)mode); }
+        ));
+        menu->addChild(createMenuItem("New tape damage seed", "",
+            [=]() { module->damageSeed = random::u32(); }
+        ));
+    }
 };
 
 Model* modelTapeAge = createModel<TapeAge, TapeAgeWidget>("TapeAge");